@@ -0,0 +1,308 @@
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QFileInfo>
+#include <QFile>
+#include <QDir>
+
+#include <csignal>
+#include <atomic>
+#include <cmath>
+#include <chrono>
+#include <random>
+#include <iostream>
+
+#include "CommandLineRecorder.h"
+#include "Tools/SoundFileWriters.h"
+#include "Tools/Resampler.h"
+
+
+static std::atomic<bool> interrupted (false);
+
+static void interrupt (int)  // Ctrl+C or kill stops the recording cleanly, the file is finalized
+{
+    interrupted = true;
+}
+
+static const double pi = 3.14159265358979323846;
+
+static double toDecibels (float level)
+{
+    return level > 0 ? 20 * std::log10 (level) : -120;
+}
+
+
+CommandLineRecorder::CommandLineRecorder () : QObject ()
+{
+    pollCount = 0;
+    maxDuration = 0;
+
+    connect (&pollTimer, SIGNAL (timeout ()), this, SLOT (update ()));
+    connect (&recorder, SIGNAL (segmentCompleted (QString)), this, SLOT (printSegment (QString)));
+}
+
+
+int CommandLineRecorder::run (const QStringList& arguments)  // Exit code, or -1 if the recording goes on in the event loop
+{
+    if (arguments.length () > 1 && arguments.at (1) == "devices")
+        return listDevices ();
+
+    if (arguments.length () > 1 && arguments.at (1) == "benchmark")
+        return benchmark (arguments);
+
+    return record (arguments);
+}
+
+int CommandLineRecorder::listDevices ()
+{
+    std::string defaultDevice = sf::SoundRecorder::getDefaultDevice ();
+
+    for (const std::string& device : sf::SoundRecorder::getAvailableDevices ())
+        std::cout << "device name=\"" << device << "\" default=" << (device == defaultDevice) << std::endl;
+
+    return 0;
+}
+
+int CommandLineRecorder::record (const QStringList& arguments)
+{
+    QCommandLineParser parser;
+    parser.setApplicationDescription ("Records one microphone without user interface.\nExit code 0 on success, 1 if recording failed, 2 on bad arguments, 3 if audio was lost.");
+    parser.addHelpOption ();
+    parser.addPositionalArgument ("record", "Command, \"devices\" lists the microphones instead.");
+    parser.addPositionalArgument ("file", "Output file, the format comes from its extension.");
+    parser.addOptions ({{"device", "Microphone to use, the default one otherwise.", "name"},
+                        {"rate", "Sample rate, 44100 by default.", "hertz", "44100"},
+                        {"capture-rate", "Rate asked to the microphone, resampled to --rate. The same as --rate by default.", "hertz", "0"},
+                        {"resampler", "fast, balanced or best, balanced by default.", "quality", "balanced"},
+                        {"channels", "1 or 2, 2 by default.", "count", "2"},
+                        {"codec", "ogg, flac, wav or opus, added to the file name if missing.", "codec"},
+                        {"duration", "Stop after this time, runs until interrupted otherwise.", "seconds", "0"},
+                        {"volume", "Input volume in percent, 100 by default.", "percent", "100"},
+                        {"protection", "clip, limit or agc, clip by default.", "mode", "clip"},
+                        {"latency", "Time between two capture callbacks, 20 by default.", "milliseconds", "20"},
+                        {"buffer", "Audio kept in memory for the encoder, 2000 by default.", "milliseconds", "2000"},
+                        {"memory", "Record to memory first and write by large blocks, for slow disks. Audio is replaced by silence if the disk stalls until it is full.", "megabytes", "0"},
+                        {"threads", "FLAC encoding threads, one per core by default.", "count", "0"},
+                        {"bitrate", "Opus bitrate, 64 by default.", "kb/s", "64"},
+                        {"complexity", "Opus complexity from 0 to 10, 10 by default.", "level", "10"},
+                        {"segment-duration", "Start a new file every N seconds.", "seconds", "0"},
+                        {"segment-size", "Start a new file above N megabytes.", "megabytes", "0"}});
+
+    bool parsed = parser.parse (arguments);
+
+    if (parsed && parser.isSet ("help"))
+    {
+        std::cout << parser.helpText ().toStdString ();
+        return 0;
+    }
+
+    if (!parsed || parser.positionalArguments ().length () != 2)
+    {
+        std::cerr << (parser.errorText ().isEmpty () ? QString ("A single output file is expected.") : parser.errorText ()).toStdString () << std::endl
+                  << parser.helpText ().toStdString ();
+
+        return 2;
+    }
+
+
+    unsigned int sampleRate = parser.value ("rate").toUInt ();
+    unsigned int captureRate = parser.value ("capture-rate").toUInt ();
+    unsigned int channelCount = parser.value ("channels").toUInt ();
+    maxDuration = parser.value ("duration").toUInt ();
+
+    outputFileName = parser.positionalArguments ().at (1);
+
+    if (parser.isSet ("codec") && QFileInfo (outputFileName).suffix ().compare (parser.value ("codec"), Qt::CaseInsensitive) != 0)
+        outputFileName += "." + parser.value ("codec").toLower ();
+
+    if (sampleRate == 0 || channelCount == 0 || channelCount > 2)
+    {
+        std::cerr << "Invalid sample rate or channel count." << std::endl;
+        return 2;
+    }
+
+
+    if (parser.isSet ("device") && !recorder.setDevice (parser.value ("device").toStdString ()))
+    {
+        printStatus ("error");
+        std::cerr << "Unknown device, \"mrecorder devices\" lists the available ones." << std::endl;
+
+        return 1;
+    }
+
+    SoundFileWriters::setEncoderThreads (parser.value ("threads").toUInt ());
+    SoundFileWriters::setOpusSettings (parser.value ("bitrate").toUInt () * 1000, parser.value ("complexity").toUInt ());
+    Resampler::setDefaultQuality (parser.value ("resampler") == "fast" ? Resampler::Fast : parser.value ("resampler") == "best" ? Resampler::Best : Resampler::Balanced);
+
+    recorder.setChannelCount (channelCount);
+    recorder.setVolume (parser.value ("volume").toUShort ());
+    recorder.setOverloadProtection (parser.value ("protection") == "clip" ? AudioRecorder::Clipping : parser.value ("protection") == "agc" ? AudioRecorder::AutomaticGain : AudioRecorder::Limiting);
+    recorder.setLatency (parser.value ("latency").toUInt ());
+    recorder.setBufferDuration (parser.value ("buffer").toUInt ());
+    recorder.setMemoryBudget (parser.value ("memory").toUInt ());
+    recorder.setSegmentLimits (parser.value ("segment-duration").toUInt (), parser.value ("segment-size").toULongLong () * 1024 * 1024);
+
+    if (!recorder.setOutputStream (std::string (outputFileName.toLocal8Bit ()), sampleRate, channelCount) || !recorder.start (captureRate != 0 ? captureRate : sampleRate))
+    {
+        printStatus ("error");
+        std::cerr << "Impossible to start recording, check the microphone and the output file." << std::endl;
+
+        return 1;
+    }
+
+
+    std::signal (SIGINT, interrupt);
+    std::signal (SIGTERM, interrupt);
+
+    pollTimer.start (100);
+    printStatus ("recording");
+
+    return -1;
+}
+
+
+int CommandLineRecorder::benchmark (const QStringList& arguments)  // Encoding cost of each codec on this machine, to size servers running many streams
+{
+    QCommandLineParser parser;
+    parser.setApplicationDescription ("Encodes the same synthetic signal with every codec and prints the time spent per second of audio.");
+    parser.addHelpOption ();
+    parser.addPositionalArgument ("benchmark", "Command.");
+    parser.addOptions ({{"seconds", "Length of the signal, 60 by default.", "seconds", "60"},
+                        {"rate", "Sample rate, 44100 by default.", "hertz", "44100"},
+                        {"channels", "1 or 2, 2 by default.", "count", "2"},
+                        {"threads", "FLAC encoding threads, 1 by default so the time is the processor cost of one stream.", "count", "1"},
+                        {"bitrate", "Opus bitrate, 64 by default.", "kb/s", "64"},
+                        {"complexity", "Opus complexity from 0 to 10, 10 by default.", "level", "10"}});
+
+    bool parsed = parser.parse (arguments);
+
+    if (parsed && parser.isSet ("help"))
+    {
+        std::cout << parser.helpText ().toStdString ();
+        return 0;
+    }
+
+    unsigned int seconds = parser.value ("seconds").toUInt ();
+    unsigned int sampleRate = parser.value ("rate").toUInt ();
+    unsigned int channelCount = parser.value ("channels").toUInt ();
+
+    if (!parsed || seconds == 0 || sampleRate == 0 || channelCount == 0 || channelCount > 2)
+    {
+        std::cerr << (parser.errorText ().isEmpty () ? QString ("Invalid duration, sample rate or channel count.") : parser.errorText ()).toStdString () << std::endl;
+        return 2;
+    }
+
+    SoundFileWriters::setEncoderThreads (parser.value ("threads").toUInt ());
+    SoundFileWriters::setOpusSettings (parser.value ("bitrate").toUInt () * 1000, parser.value ("complexity").toUInt ());
+
+
+    std::vector<sf::Int16> signal (std::size_t (seconds) * sampleRate * channelCount);  // Two drifting tones with some noise, not as easy to encode as silence
+    std::minstd_rand noise (1);
+
+    for (std::size_t frame = 0 ; frame != signal.size () / channelCount ; frame++)
+    {
+        double time = double (frame) / sampleRate;
+        double envelope = 0.5 + 0.5 * std::sin (2 * pi * 0.7 * time);
+
+        for (unsigned int channel = 0 ; channel != channelCount ; channel++)
+        {
+            double value = 6000 * envelope * std::sin (2 * pi * (220 + 30 * channel + 20 * std::sin (time)) * time)
+                         + 3000 * std::sin (2 * pi * 1870 * time)
+                         + int (noise () % 601) - 300;
+
+            signal[frame * channelCount + channel] = sf::Int16 (value);
+        }
+    }
+
+
+    std::size_t blockSamples = std::max (1U, sampleRate / 100) * channelCount;  // Written by 10 ms blocks, like a recording
+
+    for (const char* codec : {"wav", "flac", "ogg", "opus"})
+    {
+        QString fileName = QDir::temp ().filePath (QString ("MRecorder benchmark.") + codec);
+
+        auto start = std::chrono::steady_clock::now ();
+
+        std::unique_ptr<sf::SoundFileWriter> writer = SoundFileWriters::open (std::string (fileName.toLocal8Bit ()), sampleRate, channelCount);
+
+        if (!writer)
+        {
+            std::cout << "benchmark codec=" << codec << " error=1" << std::endl;
+            continue;
+        }
+
+        for (std::size_t offset = 0 ; offset < signal.size () ; offset += blockSamples)
+            writer->write (&signal[offset], std::min (blockSamples, signal.size () - offset));
+
+        writer.reset ();  // Finalizing the file is part of the cost
+
+        double milliseconds = std::chrono::duration<double, std::milli> (std::chrono::steady_clock::now () - start).count ();
+        double perSecond = milliseconds / seconds;
+
+        std::cout << "benchmark codec=" << codec
+                  << " ms_per_second=" << std::round (perSecond * 100) / 100
+                  << " realtime_factor=" << std::round (1000 / std::max (perSecond, 0.001))
+                  << " kbps=" << std::round (QFileInfo (fileName).size () * 8.0 / 1000 / seconds) << std::endl;
+
+        QFile::remove (fileName);
+    }
+
+    return 0;
+}
+
+
+////////////////////////////////////////  Slots
+
+
+void CommandLineRecorder::update ()
+{
+    if (interrupted || (maxDuration != 0 && recorder.durationAsMilliseconds () >= maxDuration))
+    {
+        finish ();
+        return;
+    }
+
+    if (++pollCount % 10 == 0)
+        printStatus ("recording");
+}
+
+void CommandLineRecorder::printSegment (const QString& fileName)
+{
+    std::cout << "segment file=\"" << std::string (fileName.toLocal8Bit ()) << "\"" << std::endl;
+}
+
+void CommandLineRecorder::finish ()
+{
+    pollTimer.stop ();
+    recorder.stop ();
+
+    printStatus ("finished");
+
+    QCoreApplication::exit (recorder.bufferOverruns () == 0 && recorder.droppedFrames () == 0 && recorder.timings ().gaps () == 0 ? 0 : 3);
+}
+
+
+////////////////////////////////////////  Others
+
+
+void CommandLineRecorder::printStatus (const char* state)  // Stable "key=value" format meant for scripts
+{
+    AudioLevels levels = recorder.levels ();
+    float peak = 0;
+
+    for (unsigned short int i = 0 ; i != levels.channelCount ; i++)
+        peak = std::max (peak, levels.channels[i].peak);
+
+    std::cout << "status state=" << state
+              << " seconds=" << (recorder.getSampleRate () != 0 ? recorder.durationAsMilliseconds () : 0)  // This one actually counts seconds
+              << " rms_db=" << std::round (toDecibels (levels.level ()) * 10) / 10
+              << " peak_db=" << std::round (toDecibels (peak) * 10) / 10
+              << " gain_reduction_db=" << std::round (levels.gainReduction * 10) / 10
+              << " overruns=" << recorder.bufferOverruns ()
+              << " gaps=" << recorder.timings ().gaps ()
+              << " memory_mb=" << recorder.memoryUsed () / (1024 * 1024)
+              << " memory_peak_mb=" << recorder.memoryPeak () / (1024 * 1024)
+              << " dropped_frames=" << recorder.droppedFrames ()
+              << " drop_events=" << recorder.dropEvents ()
+              << " max_callback_us=" << recorder.timings ().durations ().maximum ()
+              << " file=\"" << std::string (outputFileName.toLocal8Bit ()) << "\"" << std::endl;
+}
@@ -0,0 +1,49 @@
+#ifndef COMMANDLINERECORDER_H
+#define COMMANDLINERECORDER_H
+
+
+#include <QObject>
+#include <QTimer>
+#include <QStringList>
+
+#include "Tools/AudioRecorder.h"
+
+
+// Headless mode for machines without display : "mrecorder record [options] file", "mrecorder devices" or "mrecorder benchmark"
+// No widget, font or translation is loaded, one "key=value" status line is printed on stdout every second
+
+class CommandLineRecorder : public QObject
+{
+    Q_OBJECT
+
+    public:
+        CommandLineRecorder ();
+
+        int run (const QStringList&);
+
+
+    private slots:
+        void update ();
+        void printSegment (const QString&);
+
+
+    private:
+        int listDevices ();
+        int benchmark (const QStringList&);
+        int record (const QStringList&);
+        void finish ();
+
+        void printStatus (const char*);
+
+
+        AudioRecorder recorder;
+
+        QTimer pollTimer;
+        unsigned int pollCount;
+
+        unsigned int maxDuration;  // In seconds, 0 until interrupted
+        QString outputFileName;
+};
+
+
+#endif // COMMANDLINERECORDER_H
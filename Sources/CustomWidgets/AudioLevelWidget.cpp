@@ -1,31 +1,130 @@
-#include <QApplication>
-
-#include <QPainter>
-
-#include "AudioLevelWidget.h"
-
-
-AudioLevelWidget::AudioLevelWidget () : QWidget ()
-{
-    _level = 0;
-    setMinimumWidth (30);
-}
-
-
-void AudioLevelWidget::setLevel (double level)
-{
-    if (level != _level)
-    {
-        _level = level;
-        update ();
-    }
-}
-
-
-void AudioLevelWidget::paintEvent (QPaintEvent*)
-{
-    QPainter painter (this);
-
-    painter.fillRect (0, 0, width (), height () - height () * _level, qApp->palette ().window ());
-    painter.fillRect (0, height () - height () * _level, width (), height (), qApp->palette ().link ());
-}
+#include <QApplication>
+
+#include <QPainter>
+
+#include "AudioLevelWidget.h"
+
+
+static const double maxShownReduction = 20;  // dB reached at the bottom of the widget
+static const float shownRange = 60;  // dBFS at the bottom of the meters
+static const float clipLevel = -0.1;
+
+
+AudioLevelWidget::AudioLevelWidget () : QWidget ()
+{
+    channelCount = 0;
+    gainReduction = 0;
+
+    setMinimumWidth (30);
+}
+
+
+void AudioLevelWidget::setLevels (const AudioLevels& levels)
+{
+    _levels = levels;
+
+    if (levels.channelCount != channelCount)
+    {
+        channelCount = levels.channelCount;
+
+        for (unsigned short int i = 0 ; i != channelCount ; i++)
+            meters[i] = {toPixels (levels.channels[i].meterPeak), toPixels (levels.channels[i].meterRms), toPixels (levels.channels[i].heldPeak), levels.channels[i].heldPeak >= clipLevel};
+
+        gainReduction = qRound (height () * std::min (-levels.gainReduction / maxShownReduction, 1.0));
+
+        update ();
+        return;
+    }
+
+
+    for (unsigned short int i = 0 ; i != channelCount ; i++)
+    {
+        Meter meter = {toPixels (levels.channels[i].meterPeak), toPixels (levels.channels[i].meterRms), toPixels (levels.channels[i].heldPeak), levels.channels[i].heldPeak >= clipLevel};
+
+        if (meter != meters[i])
+        {
+            meters[i] = meter;
+            update (meterRect (i));
+        }
+    }
+
+    int reduction = qRound (height () * std::min (-levels.gainReduction / maxShownReduction, 1.0));
+
+    if (reduction != gainReduction)
+    {
+        gainReduction = reduction;
+        update (reductionRect ());
+    }
+}
+
+
+int AudioLevelWidget::toPixels (float decibels) const
+{
+    return qRound (height () * std::max (0.0f, std::min (1.0f, 1 + decibels / shownRange)));
+}
+
+QRect AudioLevelWidget::meterRect (unsigned short int channel) const
+{
+    int metersWidth = reductionRect ().left ();
+    int left = metersWidth * channel / channelCount;
+    int right = metersWidth * (channel + 1) / channelCount - (channel + 1 != channelCount ? 1 : 0);  // One pixel gap between the meters
+
+    return QRect (left, 0, std::max (1, right - left), height ());
+}
+
+QRect AudioLevelWidget::reductionRect () const  // Limiter activity hangs from the top, on its own strip at the right
+{
+    int stripWidth = std::max (4, width () / 6);
+
+    return QRect (width () - stripWidth, 0, stripWidth, height ());
+}
+
+
+void AudioLevelWidget::paintEvent (QPaintEvent* event)
+{
+    QPainter painter (this);
+
+    if (channelCount == 0)
+    {
+        painter.fillRect (event->rect (), qApp->palette ().window ());
+        return;
+    }
+
+
+    QColor barColor = qApp->palette ().link ().color ();
+    QColor peakColor = barColor;
+    peakColor.setAlpha (110);
+
+    for (unsigned short int i = 0 ; i != channelCount ; i++)
+    {
+        QRect area = meterRect (i);
+
+        if (!area.intersects (event->rect ()))
+            continue;
+
+        const Meter& meter = meters[i];
+
+        painter.fillRect (area, qApp->palette ().window ());
+        painter.fillRect (area.left (), height () - meter.peak, area.width (), meter.peak, peakColor);
+        painter.fillRect (area.left (), height () - meter.rms, area.width (), meter.rms, barColor);
+
+        if (meter.heldPeak > 0)
+            painter.fillRect (area.left (), height () - meter.heldPeak, area.width (), 2, qApp->palette ().text ());
+
+        if (meter.clipped)
+            painter.fillRect (area.left (), 0, area.width (), 4, Qt::red);
+    }
+
+    if (reductionRect ().intersects (event->rect ()))
+    {
+        painter.fillRect (reductionRect (), qApp->palette ().window ());
+        painter.fillRect (reductionRect ().left (), 0, reductionRect ().width (), gainReduction, Qt::red);
+    }
+}
+
+void AudioLevelWidget::resizeEvent (QResizeEvent*)  // The pixel heights depend on the size
+{
+    channelCount = 0;
+
+    setLevels (_levels);
+}
@@ -1,29 +1,57 @@
-#ifndef AUDIOLEVELWIDGET_H
-#define AUDIOLEVELWIDGET_H
-
-
-#include <QWidget>
-
-#include <QPaintEvent>
-
-
-class AudioLevelWidget : public QWidget
-{
-    Q_OBJECT
-
-    public:
-        AudioLevelWidget ();
-
-
-    public slots:
-        void setLevel (double);
-
-
-    private:
-        void paintEvent (QPaintEvent*) override;
-
-        double _level;
-};
-
-
-#endif // AUDIOLEVELWIDGET_H
+#ifndef AUDIOLEVELWIDGET_H
+#define AUDIOLEVELWIDGET_H
+
+
+#include <QWidget>
+
+#include <QPaintEvent>
+
+#include "../Tools/AudioLevels.h"
+
+
+// One meter per channel : RMS bar, peak bar behind it, held peak line and clip light, all computed on the audio side
+// Only the meters whose pixels changed are repainted
+
+class AudioLevelWidget : public QWidget
+{
+    Q_OBJECT
+
+    public:
+        AudioLevelWidget ();
+
+
+    public slots:
+        void setLevels (const AudioLevels&);
+
+
+    private:
+        struct Meter  // In pixels from the bottom
+        {
+            int peak;
+            int rms;
+            int heldPeak;
+            bool clipped;
+
+            bool operator!= (const Meter& other) const
+            {
+                return peak != other.peak || rms != other.rms || heldPeak != other.heldPeak || clipped != other.clipped;
+            }
+        };
+
+
+        void paintEvent (QPaintEvent*) override;
+        void resizeEvent (QResizeEvent*) override;
+
+        int toPixels (float) const;
+        QRect meterRect (unsigned short int) const;
+        QRect reductionRect () const;
+
+
+        AudioLevels _levels;
+        unsigned short int channelCount;
+        Meter meters[AudioLevels::maxChannels];
+        int gainReduction;
+};
+
+
+#endif // AUDIOLEVELWIDGET_H
@@ -0,0 +1,154 @@
+#include <QApplication>
+
+#include <QPainter>
+
+#include "SpectrumAnalyzerWidget.h"
+
+
+static const float shownRange = 90;  // dB between the bottom and the top of the widget, 0 dB being a full scale sine
+
+
+SpectrumAnalyzerWidget::SpectrumAnalyzerWidget () : QWidget ()
+{
+    setFixedHeight (102);
+    setToolTip (tr("Click to switch between bars and spectrogram"));
+
+    _mode = Bars;
+    nextColumn = 0;
+
+    static const QColor stops[] = {Qt::black, QColor (20, 20, 140), QColor (180, 30, 90), QColor (255, 170, 0), Qt::white};  // From silence to full scale
+
+    for (int i = 0 ; i != 256 ; i++)
+    {
+        double position = i / 255.0 * 4;
+        int stop = std::min (3, int (position));
+        double fraction = position - stop;
+
+        colors[i] = qRgb (qRound (stops[stop].red () + (stops[stop + 1].red () - stops[stop].red ()) * fraction),
+                          qRound (stops[stop].green () + (stops[stop + 1].green () - stops[stop].green ()) * fraction),
+                          qRound (stops[stop].blue () + (stops[stop + 1].blue () - stops[stop].blue ()) * fraction));
+    }
+}
+
+
+void SpectrumAnalyzerWidget::setMode (Mode newMode)
+{
+    _mode = newMode;
+
+    update ();
+}
+
+SpectrumAnalyzerWidget::Mode SpectrumAnalyzerWidget::mode () const
+{
+    return _mode;
+}
+
+
+void SpectrumAnalyzerWidget::clear ()
+{
+    bands = SpectrumBands ();
+
+    waterfall.fill (colors[0]);
+    nextColumn = 0;
+
+    update ();
+}
+
+void SpectrumAnalyzerWidget::setBands (const SpectrumBands& newBands)
+{
+    if (newBands.bandCount == 0 && bands.bandCount == 0)
+        return;
+
+    bands = newBands;
+
+    if (_mode == Bars)
+        update ();
+}
+
+void SpectrumAnalyzerWidget::addColumns (const float* magnitudes, std::size_t columnsCount, unsigned short int bandCount)
+{
+    if (waterfall.isNull () || bandCount == 0)
+        return;
+
+    int imageHeight = waterfall.height ();
+
+    for (std::size_t column = 0 ; column != columnsCount ; column++)
+    {
+        const float* columnMagnitudes = magnitudes + column * bandCount;
+
+        for (int y = 0 ; y != imageHeight ; y++)  // Low frequencies at the bottom
+        {
+            float level = std::max (0.0f, std::min (1.0f, 1 + columnMagnitudes[(imageHeight - 1 - y) * bandCount / imageHeight] / shownRange));
+
+            reinterpret_cast<QRgb*> (waterfall.scanLine (y))[nextColumn] = colors[int (level * 255)];
+        }
+
+        nextColumn = (nextColumn + 1) % waterfall.width ();
+    }
+
+    if (_mode == Spectrogram && columnsCount != 0)
+        update ();
+}
+
+
+void SpectrumAnalyzerWidget::paintEvent (QPaintEvent*)
+{
+    QPainter painter (this);
+
+    if (_mode == Spectrogram)
+    {
+        int oldestWidth = waterfall.width () - nextColumn;
+
+        painter.drawImage (0, 0, waterfall, nextColumn, 0, oldestWidth, waterfall.height ());
+
+        if (nextColumn != 0)
+            painter.drawImage (oldestWidth, 0, waterfall, 0, 0, nextColumn, waterfall.height ());
+
+        return;
+    }
+
+
+    painter.fillRect (rect (), qApp->palette ().window ());
+
+    if (bands.bandCount == 0)
+        return;
+
+    double bandWidth = double (width ()) / bands.bandCount;
+
+    for (unsigned short int i = 0 ; i != bands.bandCount ; i++)
+    {
+        double level = std::max (0.0f, std::min (1.0f, 1 + bands.magnitudes[i] / shownRange));
+        int barHeight = qRound (height () * level);
+
+        int left = qRound (i * bandWidth);
+        int right = qRound ((i + 1) * bandWidth) - 1;  // One pixel gap between the bars
+
+        painter.fillRect (left, height () - barHeight, std::max (1, right - left), barHeight, qApp->palette ().link ());
+    }
+}
+
+void SpectrumAnalyzerWidget::resizeEvent (QResizeEvent*)  // The history is kept on the right side, cut or padded on the left
+{
+    QImage resized (std::max (1, width ()), height (), QImage::Format_RGB32);
+    resized.fill (colors[0]);
+
+    if (!waterfall.isNull ())
+    {
+        int oldestWidth = waterfall.width () - nextColumn;
+        int shift = resized.width () - waterfall.width ();
+
+        QPainter painter (&resized);
+        painter.drawImage (shift, 0, waterfall, nextColumn, 0, oldestWidth, waterfall.height ());
+
+        if (nextColumn != 0)
+            painter.drawImage (shift + oldestWidth, 0, waterfall, 0, 0, nextColumn, waterfall.height ());
+    }
+
+    waterfall = resized;
+    nextColumn = 0;
+}
+
+void SpectrumAnalyzerWidget::mousePressEvent (QMouseEvent*)
+{
+    setMode (_mode == Bars ? Spectrogram : Bars);
+}
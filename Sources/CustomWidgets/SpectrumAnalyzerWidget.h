@@ -0,0 +1,56 @@
+#ifndef SPECTRUMANALYZERWIDGET_H
+#define SPECTRUMANALYZERWIDGET_H
+
+
+#include <QWidget>
+
+#include <QPaintEvent>
+#include <QImage>
+
+#include "../Tools/SpectrumAnalyzer.h"
+
+
+// Bars of the last bands, or a scrolling spectrogram : each new column is written once in a ring image,
+// painting only copies its two parts, the oldest one first
+
+class SpectrumAnalyzerWidget : public QWidget
+{
+    Q_OBJECT
+
+    public:
+        enum Mode
+        {
+            Bars,
+            Spectrogram
+        };
+
+
+        SpectrumAnalyzerWidget ();
+
+        void setMode (Mode);
+        Mode mode () const;
+
+        void addColumns (const float*, std::size_t, unsigned short int);  // Columns, their count and the bands per column
+
+
+    public slots:
+        void setBands (const SpectrumBands&);
+
+        void clear ();
+
+
+    private:
+        void paintEvent (QPaintEvent*) override;
+        void resizeEvent (QResizeEvent*) override;
+        void mousePressEvent (QMouseEvent*) override;
+
+        Mode _mode;
+        SpectrumBands bands;
+
+        QImage waterfall;
+        int nextColumn;
+        QRgb colors[256];
+};
+
+
+#endif // SPECTRUMANALYZERWIDGET_H
@@ -1,57 +1,142 @@
-#include <QApplication>
-
-#include <QPainter>
-
-#include "SpectrumWidget.h"
-
-
-SpectrumWidget::SpectrumWidget () : QWidget ()
-{
-    setFixedHeight (102);
-
-    loopCount = 5;
-}
-
-
-void SpectrumWidget::clear ()
-{
-    levels.clear ();
-    levels.shrink_to_fit ();
-
-    update ();
-}
-
-
-void SpectrumWidget::addLevel (double newLevel)
-{
-    if (loopCount == 5)
-    {
-        if (levels.size () == width ())
-            levels.removeFirst ();
-
-        levels.push_back (newLevel);
-
-        loopCount = 0;
-        update ();
-    }
-    else
-        loopCount++;
-}
-
-void SpectrumWidget::paintEvent (QPaintEvent*)
-{
-    QPainter painter (this);
-
-    painter.fillRect (0, 0, width (), 100, qApp->palette ().window ());
-    painter.fillRect (0, 49, width (), 2, qApp->palette ().link ());
-
-
-    unsigned short int picHeight;
-
-    for (short int i = 0 ; i != levels.length () ; i++)
-    {
-        picHeight = qRound (50 * levels.at (i));
-
-        painter.fillRect (i, 50 - picHeight, 1, picHeight * 2, qApp->palette ().link ());
-    }
-}
+#include <QApplication>
+
+#include <QPainter>
+
+#include "SpectrumWidget.h"
+
+
+SpectrumWidget::SpectrumWidget () : QWidget ()
+{
+    setFixedHeight (102);
+
+    nextLevel = 0;
+    levelsCount = 0;
+
+    drawnColumns = 0;
+    pendingColumns = 0;
+    redrawAll = true;
+
+    loopCount = 1;
+}
+
+
+void SpectrumWidget::clear ()
+{
+    nextLevel = 0;
+    levelsCount = 0;
+    pendingColumns = 0;
+    redrawAll = true;
+
+    update ();
+}
+
+
+void SpectrumWidget::addLevels (const AudioLevels& newLevels)
+{
+    if (loopCount == 1)  // One column every two display refreshes
+    {
+        if (!levels.empty ())
+        {
+            levels[nextLevel] = newLevels.level ();
+            nextLevel = (nextLevel + 1) % levels.size ();
+
+            levelsCount = std::min (levelsCount + 1, levels.size ());
+            pendingColumns = std::min (pendingColumns + 1, levels.size ());
+
+            update ();
+        }
+
+        loopCount = 0;
+    }
+    else
+        loopCount++;
+}
+
+
+void SpectrumWidget::paintEvent (QPaintEvent*)
+{
+    if (canvas.size () != size ())
+    {
+        canvas = QPixmap (size ());
+        redrawAll = true;
+    }
+
+    if (redrawAll)
+    {
+        canvas.fill (qApp->palette ().window ().color ());
+
+        drawnColumns = 0;
+        pendingColumns = levelsCount;
+        redrawAll = false;
+    }
+
+    if (pendingColumns != 0)
+    {
+        int overflow = drawnColumns + int (pendingColumns) - width ();
+
+        if (overflow > 0)  // Full, the history moves to the left to make room
+        {
+            canvas.scroll (-overflow, 0, canvas.rect ());
+            drawnColumns -= overflow;
+        }
+
+        QPainter canvasPainter (&canvas);
+        drawColumns (canvasPainter, drawnColumns, pendingColumns);
+
+        drawnColumns += pendingColumns;
+        pendingColumns = 0;
+    }
+
+
+    QPainter painter (this);
+    painter.drawPixmap (0, 0, canvas);
+}
+
+void SpectrumWidget::drawColumns (QPainter& painter, int x, int count)  // The newest values, from position x
+{
+    std::size_t level = (nextLevel + levels.size () - count) % levels.size ();
+
+    painter.fillRect (x, 0, count, 100, qApp->palette ().window ());
+    painter.fillRect (x, 49, count, 2, qApp->palette ().link ());
+
+    for (int i = 0 ; i != count ; i++)
+    {
+        int picHeight = qRound (50 * levels[level]);
+
+        painter.fillRect (x + i, 50 - picHeight, 1, picHeight * 2, qApp->palette ().link ());
+
+        level = (level + 1) % levels.size ();
+    }
+}
+
+
+void SpectrumWidget::resizeEvent (QResizeEvent*)  // Keeps the newest values that still fit
+{
+    std::size_t capacity = std::max (1, width ());
+
+    if (capacity == levels.size ())
+        return;
+
+    std::size_t keptCount = std::min (levelsCount, capacity);
+    std::vector<float> resized (capacity, 0);
+
+    for (std::size_t i = 0 ; i != keptCount ; i++)
+        resized[i] = levels[(nextLevel + levels.size () - keptCount + i) % levels.size ()];
+
+    levels.swap (resized);
+    levelsCount = keptCount;
+    nextLevel = keptCount % capacity;
+
+    redrawAll = true;
+}
+
+void SpectrumWidget::changeEvent (QEvent* event)  // The colors come from the palette, a theme change needs a full redraw
+{
+    if (event->type () == QEvent::PaletteChange || event->type () == QEvent::ApplicationPaletteChange)
+    {
+        redrawAll = true;
+        update ();
+    }
+
+    QWidget::changeEvent (event);
+}
@@ -1,32 +1,53 @@
-#ifndef SPECTRUMWIDGET_H
-#define SPECTRUMWIDGET_H
-
-
-#include <QWidget>
-
-#include <QPaintEvent>
-
-
-class SpectrumWidget : public QWidget
-{
-    Q_OBJECT
-
-    public:
-        SpectrumWidget ();
-
-
-    public slots:
-        void addLevel (double);
-
-        void clear ();
-
-
-    private:
-        void paintEvent (QPaintEvent*) override;
-
-        QVector<double> levels;
-        unsigned short int loopCount;
-};
-
-
-#endif // SPECTRUMWIDGET_H
+#ifndef SPECTRUMWIDGET_H
+#define SPECTRUMWIDGET_H
+
+
+#include <QWidget>
+
+#include <QPaintEvent>
+#include <QPixmap>
+
+#include <vector>
+
+#include "../Tools/AudioLevels.h"
+
+
+// Level history : one column per value in a circular buffer as wide as the widget,
+// the picture is cached and each refresh only scrolls it and draws the new columns
+
+class SpectrumWidget : public QWidget
+{
+    Q_OBJECT
+
+    public:
+        SpectrumWidget ();
+
+
+    public slots:
+        void addLevels (const AudioLevels&);
+
+        void clear ();
+
+
+    private:
+        void paintEvent (QPaintEvent*) override;
+        void resizeEvent (QResizeEvent*) override;
+        void changeEvent (QEvent*) override;
+
+        void drawColumns (QPainter&, int, int);
+
+
+        std::vector<float> levels;
+        std::size_t nextLevel;  // Where the next value goes, the oldest one once the buffer is full
+        std::size_t levelsCount;
+
+        QPixmap canvas;
+        int drawnColumns;
+        std::size_t pendingColumns;  // Added since the last paint
+        bool redrawAll;
+
+        unsigned short int loopCount;
+};
+
+
+#endif // SPECTRUMWIDGET_H
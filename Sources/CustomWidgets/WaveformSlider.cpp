@@ -0,0 +1,244 @@
+#include <QPainter>
+#include <QMouseEvent>
+#include <QWheelEvent>
+
+#include <cmath>
+#include <algorithm>
+
+#include "WaveformSlider.h"
+
+
+static const double minViewLength = 100;  // Milliseconds, the finest level of the overview is already below a pixel there
+static const double zoomStep = 0.8;  // View length factor per wheel notch
+
+
+WaveformSlider::WaveformSlider () : DirectJumpSlider ()
+{
+    setMinimumHeight (48);
+    setToolTip (tr("Click to jump, wheel to zoom, right click and drag to move"));
+
+    viewStart = 0;
+    viewLength = 0;
+
+    panOrigin = 0;
+    panStart = 0;
+
+    waveformOutdated = true;
+}
+
+
+void WaveformSlider::setRecording (const QString& newFileName)  // The overview is mapped, not read, and drawn at the next paint
+{
+    fileName = newFileName;
+
+    if (fileName.isEmpty () || !peaks.open (fileName))
+        peaks.close ();
+
+    waveformOutdated = true;
+    update ();
+}
+
+void WaveformSlider::recordingScanned (const QString& scannedFile)  // Its overview was missing when it was selected
+{
+    if (scannedFile == fileName)
+        setRecording (fileName);
+}
+
+int WaveformSlider::visibleLength () const
+{
+    return int (viewLength);
+}
+
+
+////////////////////////////////////////  View
+
+
+void WaveformSlider::setView (double start, double length)
+{
+    double fullLength = maximum () - minimum ();
+
+    viewLength = std::max (std::min (minViewLength, fullLength), std::min (length, fullLength));
+    viewStart = std::max (double (minimum ()), std::min (start, maximum () - viewLength));
+
+    waveformOutdated = true;
+    update ();
+}
+
+int WaveformSlider::valueAt (int x) const
+{
+    if (width () == 0)
+        return minimum ();
+
+    return std::max (minimum (), std::min (maximum (), int (std::lround (viewStart + double (x) * viewLength / width ()))));
+}
+
+int WaveformSlider::positionOf (int sliderValue) const
+{
+    if (viewLength <= 0)
+        return 0;
+
+    return int (std::lround ((sliderValue - viewStart) * width () / viewLength));
+}
+
+
+void WaveformSlider::sliderChange (SliderChange change)
+{
+    if (change == SliderRangeChange)
+        setView (minimum (), maximum () - minimum ());
+
+    else if (change == SliderValueChange && !isSliderDown () && (value () < viewStart || value () > viewStart + viewLength))
+        setView (value (), viewLength);  // Playback left the zoomed part, the next page is shown
+
+    DirectJumpSlider::sliderChange (change);
+}
+
+
+////////////////////////////////////////  Painting
+
+
+void WaveformSlider::paintEvent (QPaintEvent*)
+{
+    if (waveformOutdated || waveform.size () != size ())
+        drawWaveform ();
+
+    QPainter painter (this);
+    painter.drawPixmap (0, 0, waveform);
+
+    if (maximum () == minimum ())
+        return;
+
+
+    int x = positionOf (value ());
+
+    QColor played = palette ().highlight ().color ();
+    played.setAlpha (60);
+
+    painter.fillRect (0, 0, std::max (0, std::min (x, width ())), height (), played);
+
+    if (x >= 0 && x < width ())
+    {
+        painter.setPen (palette ().text ().color ());
+        painter.drawLine (x, 0, x, height () - 1);
+    }
+}
+
+void WaveformSlider::drawWaveform ()  // One overview entry per pixel, whatever the length of the recording
+{
+    waveformOutdated = false;
+
+    waveform = QPixmap (size ());
+    waveform.fill (palette ().base ().color ());
+
+    QPainter painter (&waveform);
+
+    int center = height () / 2;
+
+    painter.setPen (palette ().mid ().color ());
+    painter.drawLine (0, center, width () - 1, center);
+
+    if (!peaks.isOpen () || peaks.frames () == 0 || viewLength <= 0 || width () == 0)
+        return;
+
+
+    double framesPerMillisecond = peaks.sampleRate () / 1000.0;
+
+    pixels.resize (width ());
+    peaks.overview (viewStart * framesPerMillisecond, viewLength * framesPerMillisecond / width (), &pixels[0], width ());
+
+    QVector<QLine> peakLines, rmsLines;
+    peakLines.reserve (width ());
+    rmsLines.reserve (width ());
+
+    double scale = (height () / 2 - 1) / 32768.0;
+
+    for (int x = 0 ; x != width () ; x++)
+    {
+        const PeakEntry& entry = pixels[x];
+
+        peakLines.append (QLine (x, center - int (entry.maximum * scale), x, center - int (entry.minimum * scale)));
+        rmsLines.append (QLine (x, center - int (entry.rms * scale), x, center + int (entry.rms * scale)));
+    }
+
+    painter.setPen (palette ().dark ().color ());
+    painter.drawLines (peakLines);
+
+    painter.setPen (palette ().highlight ().color ());
+    painter.drawLines (rmsLines);
+}
+
+
+void WaveformSlider::resizeEvent (QResizeEvent* event)
+{
+    waveformOutdated = true;
+
+    DirectJumpSlider::resizeEvent (event);
+}
+
+void WaveformSlider::changeEvent (QEvent* event)
+{
+    if (event->type () == QEvent::PaletteChange || event->type () == QEvent::ApplicationPaletteChange)
+        waveformOutdated = true;
+
+    DirectJumpSlider::changeEvent (event);
+}
+
+
+////////////////////////////////////////  Mouse
+
+
+void WaveformSlider::mousePressEvent (QMouseEvent* event)  // Anywhere, the whole bar acts as the handle
+{
+    if (event->button () == Qt::LeftButton)
+    {
+        setSliderDown (true);
+        setValue (valueAt (event->x ()));
+
+        emit directJumpOperated ();
+    }
+    else if (event->button () == Qt::RightButton)
+    {
+        panOrigin = event->x ();
+        panStart = viewStart;
+    }
+
+    event->accept ();
+}
+
+void WaveformSlider::mouseMoveEvent (QMouseEvent* event)
+{
+    if (isSliderDown ())
+    {
+        setValue (valueAt (event->x ()));
+        emit sliderMoved (value ());
+    }
+    else if ((event->buttons () & Qt::RightButton) && width () != 0)
+        setView (panStart - (event->x () - panOrigin) * viewLength / width (), viewLength);
+
+    event->accept ();
+}
+
+void WaveformSlider::mouseReleaseEvent (QMouseEvent* event)
+{
+    if (event->button () == Qt::LeftButton && isSliderDown ())
+        setSliderDown (false);
+
+    event->accept ();
+}
+
+void WaveformSlider::wheelEvent (QWheelEvent* event)  // Shift or a horizontal wheel moves the view, the vertical one zooms
+{
+    QPoint delta = event->angleDelta ();
+
+    if (delta.x () != 0 || (event->modifiers () & Qt::ShiftModifier))
+        setView (viewStart - (delta.x () != 0 ? delta.x () : delta.y ()) / 120.0 * viewLength / 10, viewLength);
+
+    else if (delta.y () != 0 && width () != 0)
+    {
+        double anchor = viewStart + double (event->x ()) * viewLength / width ();  // Stays under the mouse
+        double newLength = viewLength * std::pow (zoomStep, delta.y () / 120.0);
+
+        setView (anchor - double (event->x ()) * newLength / width (), newLength);
+    }
+
+    event->accept ();
+}
@@ -0,0 +1,66 @@
+#ifndef WAVEFORMSLIDER_H
+#define WAVEFORMSLIDER_H
+
+
+#include "DirectJumpSlider.h"
+
+#include <QPixmap>
+
+#include <vector>
+
+#include "../Tools/PeakFile.h"
+
+
+// Playback bar drawn over the waveform of the recording, values in milliseconds like the slider it replaces
+// A click jumps there, the wheel zooms around the mouse and a right button drag moves the visible part
+// The waveform comes from the cached overview and is only redrawn when the view changes, playback only moves a line
+
+class WaveformSlider : public DirectJumpSlider
+{
+    Q_OBJECT
+
+    public:
+        WaveformSlider ();
+
+        void setRecording (const QString&);
+        int visibleLength () const;  // Milliseconds shown
+
+
+    public slots:
+        void recordingScanned (const QString&);
+
+
+    private:
+        void paintEvent (QPaintEvent*) override;
+        void resizeEvent (QResizeEvent*) override;
+        void changeEvent (QEvent*) override;
+
+        void mousePressEvent (QMouseEvent*) override;
+        void mouseMoveEvent (QMouseEvent*) override;
+        void mouseReleaseEvent (QMouseEvent*) override;
+        void wheelEvent (QWheelEvent*) override;
+
+        void sliderChange (SliderChange) override;
+
+        void setView (double, double);
+        int valueAt (int) const;
+        int positionOf (int) const;
+        void drawWaveform ();
+
+
+        QString fileName;
+        PeakFile peaks;
+
+        double viewStart;  // In milliseconds
+        double viewLength;
+
+        int panOrigin;  // Mouse and view positions when the right button was pressed
+        double panStart;
+
+        QPixmap waveform;
+        bool waveformOutdated;
+        std::vector<PeakEntry> pixels;
+};
+
+
+#endif // WAVEFORMSLIDER_H
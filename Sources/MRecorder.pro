@@ -1,74 +1,137 @@
-QT += widgets
-
-CONFIG += c++17
-
-
-SOURCES += \
-        Application.cpp \
-        RecorderWidget.cpp \
-        RecordingsManagerWidget.cpp \
-        ConverterWidget.cpp \
-        OptionsWidget.cpp \
-        CustomWidgets/AudioLevelWidget.cpp \
-        CustomWidgets/SpectrumWidget.cpp \
-        CustomWidgets/DirectJumpSlider.cpp \
-        CustomWidgets/DevicesComboBox.cpp \
-        Tools/AudioRecorder.cpp \
-        Tools/Converter.cpp \
-        main.cpp
-
-
-HEADERS += \
-        Application.h \
-        RecorderWidget.h \
-        RecordingsManagerWidget.h \
-        ConverterWidget.h \
-        OptionsWidget.h \
-        CustomWidgets/AudioLevelWidget.h \
-        CustomWidgets/SpectrumWidget.h \
-        CustomWidgets/DirectJumpSlider.h \
-        CustomWidgets/DevicesComboBox.h \
-        Tools/AudioRecorder.h \
-        Tools/Converter.h
-
-
-RC_FILE = resources.rc
-
-
-LIBS += -LC:/SFML/lib
-
-#Release Configuration
-CONFIG(release, debug|release):
-{
-#Audio Related Libs
-LIBS += -lsfml-audio          #SFML Dynamic Module
-LIBS += -lopenal32              #Dependency
-LIBS += -lFLAC                  #Dependency
-LIBS += -lvorbisenc             #Dependency
-LIBS += -lvorbisfile            #Dependency
-LIBS += -lvorbis                #Dependency
-LIBS += -logg                   #Dependency
-
-#SFML-Graphics Libs
-LIBS += -lsfml-graphics       #SFML Dynamic Module
-LIBS += -lfreetype              #Dependency
-
-#SFML-Network Libs
-LIBS += -lsfml-network        #SFML Dynamic Module
-LIBS += -lws2_32                #Dependency
-
-#SFML-Window Libs
-LIBS += -lsfml-window         #SFML Dynamic Module
-LIBS += -lopengl32              #Dependency
-LIBS += -lgdi32                 #Dependency
-
-#SFML-System Libs
-LIBS += -lsfml-system         #SFML Dynamic Module
-LIBS += -lwinmm                 #Dependency
-}
-
-INCLUDEPATH += C:/SFML/include
-DEPENDPATH += C:/SFML/include
-
-
-TRANSLATIONS = mrecorder_fr.ts
+QT += widgets
+
+CONFIG += c++17
+
+
+SOURCES += \
+        Application.cpp \
+        RecorderWidget.cpp \
+        RecordingsManagerWidget.cpp \
+        ConverterWidget.cpp \
+        OptionsWidget.cpp \
+        CommandLineRecorder.cpp \
+        CustomWidgets/AudioLevelWidget.cpp \
+        CustomWidgets/SpectrumWidget.cpp \
+        CustomWidgets/SpectrumAnalyzerWidget.cpp \
+        CustomWidgets/DirectJumpSlider.cpp \
+        CustomWidgets/WaveformSlider.cpp \
+        CustomWidgets/DevicesComboBox.cpp \
+        Tools/AudioRecorder.cpp \
+        Tools/RecordingSession.cpp \
+        Tools/SamplesWriter.cpp \
+        Tools/SampleStore.cpp \
+        Tools/Resampler.cpp \
+        Tools/FFT.cpp \
+        Tools/SpectrumAnalyzer.cpp \
+        Tools/MeterBallistics.cpp \
+        Tools/PeakFile.cpp \
+        Tools/CacheFiles.cpp \
+        Tools/RecordingScanner.cpp \
+        Tools/RecordingInfo.cpp \
+        Tools/SeekIndex.cpp \
+        Tools/RecordingStream.cpp \
+        Tools/VorbisReader.cpp \
+        Tools/FlacReader.cpp \
+        Tools/OpusReader.cpp \
+        Tools/GainKernel.cpp \
+        Tools/SilenceGate.cpp \
+        Tools/Limiter.cpp \
+        Tools/CaptureTimings.cpp \
+        Tools/FlacWriter.cpp \
+        Tools/OpusWriter.cpp \
+        Tools/WavWriter.cpp \
+        Tools/SoundFileWriters.cpp \
+        Tools/Converter.cpp \
+        main.cpp
+
+
+HEADERS += \
+        Application.h \
+        RecorderWidget.h \
+        RecordingsManagerWidget.h \
+        ConverterWidget.h \
+        OptionsWidget.h \
+        CommandLineRecorder.h \
+        CustomWidgets/AudioLevelWidget.h \
+        CustomWidgets/SpectrumWidget.h \
+        CustomWidgets/SpectrumAnalyzerWidget.h \
+        CustomWidgets/DirectJumpSlider.h \
+        CustomWidgets/WaveformSlider.h \
+        CustomWidgets/DevicesComboBox.h \
+        Tools/AudioRecorder.h \
+        Tools/RecordingSession.h \
+        Tools/SamplesWriter.h \
+        Tools/SampleStore.h \
+        Tools/Resampler.h \
+        Tools/FFT.h \
+        Tools/SpectrumAnalyzer.h \
+        Tools/MeterBallistics.h \
+        Tools/PeakFile.h \
+        Tools/CacheFiles.h \
+        Tools/RecordingScanner.h \
+        Tools/RecordingInfo.h \
+        Tools/SeekIndex.h \
+        Tools/RecordingStream.h \
+        Tools/VorbisReader.h \
+        Tools/FlacReader.h \
+        Tools/OpusReader.h \
+        Tools/RingBuffer.h \
+        Tools/PreRollBuffer.h \
+        Tools/GainKernel.h \
+        Tools/SilenceGate.h \
+        Tools/Limiter.h \
+        Tools/CaptureTimings.h \
+        Tools/TimingHistogram.h \
+        Tools/FlacWriter.h \
+        Tools/OpusWriter.h \
+        Tools/WavWriter.h \
+        Tools/SoundFileWriters.h \
+        Tools/AudioLevels.h \
+        Tools/SeqLock.h \
+        Tools/Converter.h
+
+
+RC_FILE = resources.rc
+
+
+LIBS += -LC:/SFML/lib
+
+#Release Configuration
+CONFIG(release, debug|release):
+{
+#Audio Related Libs
+LIBS += -lsfml-audio          #SFML Dynamic Module
+LIBS += -lopenal32              #Dependency
+LIBS += -lFLAC                  #Dependency
+LIBS += -lvorbisenc             #Dependency
+LIBS += -lvorbisfile            #Dependency
+LIBS += -lvorbis                #Dependency
+LIBS += -logg                   #Dependency
+LIBS += -lopusfile              #OpusReader
+LIBS += -lopus                  #OpusWriter, pages through libogg
+
+#SFML-Graphics Libs
+LIBS += -lsfml-graphics       #SFML Dynamic Module
+LIBS += -lfreetype              #Dependency
+
+#SFML-Network Libs
+LIBS += -lsfml-network        #SFML Dynamic Module
+LIBS += -lws2_32                #Dependency
+
+#SFML-Window Libs
+LIBS += -lsfml-window         #SFML Dynamic Module
+LIBS += -lopengl32              #Dependency
+LIBS += -lgdi32                 #Dependency
+
+#SFML-System Libs
+LIBS += -lsfml-system         #SFML Dynamic Module
+LIBS += -lwinmm                 #Dependency
+}
+
+DEFINES += FLAC__NO_DLL          #FlacReader, libFLAC is linked statically
+
+INCLUDEPATH += C:/SFML/include
+DEPENDPATH += C:/SFML/include
+
+
+TRANSLATIONS = mrecorder_fr.ts
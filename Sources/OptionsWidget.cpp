@@ -1,174 +1,322 @@
-#include <QProcess>
-#include <QThread>
-#include <QStyleFactory>
-
-#include <fstream>
-#include <QFile>
-
-#include "OptionsWidget.h"
-
-
-////////////// Initialize widget
-
-
-OptionsWidget::OptionsWidget () : QWidget ()
-{
-    layout = new QGridLayout (this);
-    initPalettes ();
-
-
-    aboutLabel = new QLabel (tr(
-        "This opensource software was developed by NY4N_M4THS (MemeTech INC)<br/>"
-        "under <a href = 'https://gnu.org/licenses/lgpl-3.0.en.html'>LGPL 3.0</a> with the framework <a href = 'https://qt.io'>Qt</a> and <a href = 'https://sfml-dev.org'>SFML</a> in C++ language.<br/>"
-        "You can also visit <a href = 'https://memetech-inc.weebly.com'>our website</a> to check for updates,<br/>"
-        "try other of our applications or <a href = 'https://github.com/NyanMaths/MRecorder/issues'>ask for new features</a> !<br/>"
-        "Click <a href = 'https://github.com/NyanMaths/MRecorder'>here</a> to visit the GitHub page of the project."));
-
-    aboutLabel->setOpenExternalLinks (true);
-    aboutLabel->setTextInteractionFlags (Qt::TextBrowserInteraction);
-    aboutLabel->setTextFormat (Qt::RichText);
-
-
-    initOptionsBox ();
-
-
-    NY4N_M4THS = new QLabel;
-    NY4N_M4THS->setPixmap (QPixmap ("NY4N_M4THS.png"));
-
-
-    layout->addWidget (aboutLabel, 0, 0, 1, 3);
-    layout->addWidget (NY4N_M4THS, 0, 3, Qt::AlignRight);
-    layout->addWidget (UIOptionsBox, 1, 0, 1, 2);
-
-    loadOptions ();
-}
-
-void OptionsWidget::initOptionsBox ()
-{
-    UIOptionsBox = new QGroupBox (tr("UI options"));
-    UIOptionsBoxLayout = new QGridLayout (UIOptionsBox);
-    UIOptionsBoxLayout->setAlignment (Qt::AlignLeft);
-
-    chooseLanguageLabel = new QLabel (tr("Display language :"));
-
-    languageSelecter = new QComboBox;
-    languageSelecter->addItem ("English", QVariant ("en"));
-    languageSelecter->addItem ("Français", QVariant ("fr"));
-
-
-    chooseThemeLabel = new QLabel (tr("Interface theme :"));
-
-    themeSelecter = new QComboBox;
-    themeSelecter->addItem (tr("Classic light"));
-    themeSelecter->addItem (tr("Fusion light"));
-    themeSelecter->addItem (tr("Fusion dark"));
-    connect (themeSelecter, SIGNAL (currentIndexChanged (int)), this, SLOT (changeTheme (int)));
-
-
-    UIOptionsBoxLayout->addWidget (chooseLanguageLabel, 0, 0);
-    UIOptionsBoxLayout->addWidget (languageSelecter, 0, 1);
-    UIOptionsBoxLayout->addWidget (chooseThemeLabel, 1, 0);
-    UIOptionsBoxLayout->addWidget (themeSelecter, 1, 1);
-}
-
-
-void OptionsWidget::loadOptions ()
-{
-    QStringList settings {"en", "English", "0"};
-
-
-    QFile settingsFile ("UI Options.pastouche");
-
-    if (settingsFile.open (QIODevice::ReadOnly | QIODevice::Text))
-    {
-        QStringList readSettings = QString (settingsFile.readAll ()).split ("\n");
-
-        if (readSettings.length () == settings.length ())
-            settings = readSettings;
-    }
-
-    languageSelecter->setCurrentText (settings.at (1));
-    themeSelecter->setCurrentIndex (settings.at (2).toUShort ());
-
-
-    connect (languageSelecter, SIGNAL (currentIndexChanged (int)), this, SLOT (promptToRestart ()));
-}
-
-
-OptionsWidget::~OptionsWidget ()
-{
-    std::ofstream settingsFile ("UI Options.pastouche");
-
-    if (settingsFile)
-    {
-        settingsFile<<languageSelecter->currentData ().toString ().toStdString ()<<"\n"
-                    <<languageSelecter->currentText ().toStdString ()<<"\n"
-                    <<themeSelecter->currentIndex ();
-    }
-}
-
-
-////////////// Slots
-
-
-void OptionsWidget::changeTheme (int themeIndex)
-{
-    if (themeIndex == 0)
-    {
-        qApp->setStyle (QStyleFactory::create ("WindowsVista"));
-        qApp->setPalette (lightPalette);
-    }
-    else if (themeIndex == 1)
-    {
-        qApp->setStyle (QStyleFactory::create ("Fusion"));
-        qApp->setPalette (lightPalette);
-    }
-    else
-    {
-        qApp->setStyle (QStyleFactory::create ("Fusion"));
-        qApp->setPalette (darkPalette);
-    }
-
-    qApp->setFont (QFont ("Ubuntu"));
-}
-
-void OptionsWidget::promptToRestart ()
-{
-    if (QMessageBox::question (this, tr("Language changed"), tr("You need to reload the application to apply changes.\nDo you want to restart now ?")) == QMessageBox::Yes)
-    {
-        qApp->quit ();
-        QProcess::startDetached (qApp->arguments ()[0], qApp->arguments ());
-    }
-}
-
-
-////////////// Others
-
-
-void OptionsWidget::initPalettes ()
-{
-    lightPalette = qApp->palette ();
-
-
-    darkPalette.setColor (QPalette::Window, QColor (53,53,53));
-    darkPalette.setColor (QPalette::WindowText, Qt::white);
-    darkPalette.setColor (QPalette::Disabled, QPalette::WindowText, QColor (127,127,127));
-    darkPalette.setColor (QPalette::Base, QColor (42,42,42));
-    darkPalette.setColor (QPalette::AlternateBase, QColor (66,66,66));
-    darkPalette.setColor (QPalette::ToolTipBase, Qt::white);
-    darkPalette.setColor (QPalette::ToolTipText, Qt::white);
-    darkPalette.setColor (QPalette::Text, Qt::white);
-    darkPalette.setColor (QPalette::Disabled, QPalette::Text, QColor (127,127,127));
-    darkPalette.setColor (QPalette::Dark, QColor (35,35,35));
-    darkPalette.setColor (QPalette::Shadow, QColor (20,20,20));
-    darkPalette.setColor (QPalette::Button, QColor (53,53,53));
-    darkPalette.setColor (QPalette::ButtonText, Qt::white);
-    darkPalette.setColor (QPalette::Disabled, QPalette::ButtonText, QColor (127,127,127));
-    darkPalette.setColor (QPalette::BrightText, Qt::red);
-    darkPalette.setColor (QPalette::Link, QColor (42,130,218));
-    darkPalette.setColor (QPalette::Highlight, QColor (42,130,218));
-    darkPalette.setColor (QPalette::Disabled, QPalette::Highlight, QColor (80,80,80));
-    darkPalette.setColor (QPalette::HighlightedText, Qt::white);
-    darkPalette.setColor (QPalette::Disabled, QPalette::HighlightedText, QColor (127,127,127));
-}
-
+#include <QProcess>
+#include <QThread>
+#include <QStyleFactory>
+
+#include <fstream>
+#include <QFile>
+
+#include "OptionsWidget.h"
+#include "Tools/SoundFileWriters.h"
+#include "Tools/Resampler.h"
+#include "Tools/SpectrumAnalyzer.h"
+
+
+////////////// Initialize widget
+
+
+OptionsWidget::OptionsWidget () : QWidget ()
+{
+    layout = new QGridLayout (this);
+    initPalettes ();
+
+
+    aboutLabel = new QLabel (tr(
+        "This opensource software was developed by NY4N_M4THS (MemeTech INC)<br/>"
+        "under <a href = 'https://gnu.org/licenses/lgpl-3.0.en.html'>LGPL 3.0</a> with the framework <a href = 'https://qt.io'>Qt</a> and <a href = 'https://sfml-dev.org'>SFML</a> in C++ language.<br/>"
+        "You can also visit <a href = 'https://memetech-inc.weebly.com'>our website</a> to check for updates,<br/>"
+        "try other of our applications or <a href = 'https://github.com/NyanMaths/MRecorder/issues'>ask for new features</a> !<br/>"
+        "Click <a href = 'https://github.com/NyanMaths/MRecorder'>here</a> to visit the GitHub page of the project."));
+
+    aboutLabel->setOpenExternalLinks (true);
+    aboutLabel->setTextInteractionFlags (Qt::TextBrowserInteraction);
+    aboutLabel->setTextFormat (Qt::RichText);
+
+
+    initOptionsBox ();
+    initPerformanceBox ();
+    initOpusBox ();
+    initAnalyzerBox ();
+
+
+    NY4N_M4THS = new QLabel;
+    NY4N_M4THS->setPixmap (QPixmap ("NY4N_M4THS.png"));
+
+
+    layout->addWidget (aboutLabel, 0, 0, 1, 3);
+    layout->addWidget (NY4N_M4THS, 0, 3, Qt::AlignRight);
+    layout->addWidget (UIOptionsBox, 1, 0, 1, 2);
+    layout->addWidget (performanceBox, 1, 2, 1, 2);
+    layout->addWidget (opusBox, 2, 0, 1, 2);
+    layout->addWidget (analyzerBox, 2, 2, 1, 2);
+
+    loadOptions ();
+}
+
+void OptionsWidget::initOptionsBox ()
+{
+    UIOptionsBox = new QGroupBox (tr("UI options"));
+    UIOptionsBoxLayout = new QGridLayout (UIOptionsBox);
+    UIOptionsBoxLayout->setAlignment (Qt::AlignLeft);
+
+    chooseLanguageLabel = new QLabel (tr("Display language :"));
+
+    languageSelecter = new QComboBox;
+    languageSelecter->addItem ("English", QVariant ("en"));
+    languageSelecter->addItem ("Français", QVariant ("fr"));
+
+
+    chooseThemeLabel = new QLabel (tr("Interface theme :"));
+
+    themeSelecter = new QComboBox;
+    themeSelecter->addItem (tr("Classic light"));
+    themeSelecter->addItem (tr("Fusion light"));
+    themeSelecter->addItem (tr("Fusion dark"));
+    connect (themeSelecter, SIGNAL (currentIndexChanged (int)), this, SLOT (changeTheme (int)));
+
+
+    UIOptionsBoxLayout->addWidget (chooseLanguageLabel, 0, 0);
+    UIOptionsBoxLayout->addWidget (languageSelecter, 0, 1);
+    UIOptionsBoxLayout->addWidget (chooseThemeLabel, 1, 0);
+    UIOptionsBoxLayout->addWidget (themeSelecter, 1, 1);
+}
+
+void OptionsWidget::initPerformanceBox ()
+{
+    performanceBox = new QGroupBox (tr("Performance"));
+    performanceBoxLayout = new QGridLayout (performanceBox);
+    performanceBoxLayout->setAlignment (Qt::AlignLeft);
+
+    chooseEncoderThreadsLabel = new QLabel (tr("FLAC encoding threads :"));
+
+    encoderThreadsSelecter = new QSpinBox;
+    encoderThreadsSelecter->setRange (0, 64);
+    encoderThreadsSelecter->setSpecialValueText (tr("One per core (%1)").arg (QThread::idealThreadCount ()));
+    encoderThreadsSelecter->setToolTip (tr("Used by the recorder and the converter, the files are the same whatever this value"));
+
+    chooseResamplingQualityLabel = new QLabel (tr("Resampling quality :"));
+
+    resamplingQualitySelecter = new QComboBox;
+    resamplingQualitySelecter->addItem (tr("Fast"));
+    resamplingQualitySelecter->addItem (tr("Balanced"));
+    resamplingQualitySelecter->addItem (tr("Best"));
+    resamplingQualitySelecter->setToolTip (tr("Used when the microphone or the source file has another rate than the output file"));
+
+
+    performanceBoxLayout->addWidget (chooseEncoderThreadsLabel, 0, 0);
+    performanceBoxLayout->addWidget (encoderThreadsSelecter, 0, 1);
+    performanceBoxLayout->addWidget (chooseResamplingQualityLabel, 1, 0);
+    performanceBoxLayout->addWidget (resamplingQualitySelecter, 1, 1);
+}
+
+void OptionsWidget::initOpusBox ()
+{
+    opusBox = new QGroupBox (tr("Opus encoder"));
+    opusBoxLayout = new QGridLayout (opusBox);
+    opusBoxLayout->setAlignment (Qt::AlignLeft);
+
+    chooseOpusBitrateLabel = new QLabel (tr("Bitrate :"));
+
+    opusBitrateSelecter = new QSpinBox;
+    opusBitrateSelecter->setRange (6, 510);
+    opusBitrateSelecter->setSuffix (tr(" kb/s"));
+    opusBitrateSelecter->setToolTip (tr("About 24 kb/s is enough for speech and 96 kb/s for music in stereo"));
+
+
+    chooseOpusComplexityLabel = new QLabel (tr("Complexity :"));
+
+    opusComplexitySelecter = new QSpinBox;
+    opusComplexitySelecter->setRange (0, 10);
+    opusComplexitySelecter->setToolTip (tr("Lower values use less processor time for a slightly lower quality, \"mrecorder benchmark\" measures it"));
+
+
+    opusBoxLayout->addWidget (chooseOpusBitrateLabel, 0, 0);
+    opusBoxLayout->addWidget (opusBitrateSelecter, 0, 1);
+    opusBoxLayout->addWidget (chooseOpusComplexityLabel, 1, 0);
+    opusBoxLayout->addWidget (opusComplexitySelecter, 1, 1);
+}
+
+void OptionsWidget::initAnalyzerBox ()
+{
+    analyzerBox = new QGroupBox (tr("Spectrum analyzer"));
+    analyzerBoxLayout = new QGridLayout (analyzerBox);
+    analyzerBoxLayout->setAlignment (Qt::AlignLeft);
+
+    chooseFFTSizeLabel = new QLabel (tr("Window size :"));
+
+    FFTSizeSelecter = new QComboBox;
+
+    for (unsigned int size = 512 ; size <= 8192 ; size *= 2)
+        FFTSizeSelecter->addItem (tr("%1 samples").arg (size), QVariant (size));
+
+    FFTSizeSelecter->setToolTip (tr("Bigger windows separate close frequencies better but react slower"));
+
+
+    chooseOverlapLabel = new QLabel (tr("Overlap :"));
+
+    overlapSelecter = new QSpinBox;
+    overlapSelecter->setRange (0, 90);
+    overlapSelecter->setSingleStep (5);
+    overlapSelecter->setSuffix (" %");
+    overlapSelecter->setToolTip (tr("More overlap gives more frequent updates for more processor time"));
+
+
+    chooseBandCountLabel = new QLabel (tr("Frequency bands :"));
+
+    bandCountSelecter = new QSpinBox;
+    bandCountSelecter->setRange (8, SpectrumBands::maxBands);
+
+
+    analyzerBoxLayout->addWidget (chooseFFTSizeLabel, 0, 0);
+    analyzerBoxLayout->addWidget (FFTSizeSelecter, 0, 1);
+    analyzerBoxLayout->addWidget (chooseOverlapLabel, 1, 0);
+    analyzerBoxLayout->addWidget (overlapSelecter, 1, 1);
+    analyzerBoxLayout->addWidget (chooseBandCountLabel, 2, 0);
+    analyzerBoxLayout->addWidget (bandCountSelecter, 2, 1);
+}
+
+
+void OptionsWidget::loadOptions ()
+{
+    QStringList settings {"en", "English", "0", "0", "64", "10", "1", "2", "75", "64"};
+
+
+    QFile settingsFile ("UI Options.pastouche");
+
+    if (settingsFile.open (QIODevice::ReadOnly | QIODevice::Text))
+    {
+        QStringList readSettings = QString (settingsFile.readAll ()).split ("\n");
+
+        if (readSettings.length () == settings.length ())
+            settings = readSettings;
+    }
+
+    languageSelecter->setCurrentText (settings.at (1));
+    themeSelecter->setCurrentIndex (settings.at (2).toUShort ());
+    encoderThreadsSelecter->setValue (settings.at (3).toUShort ());
+    setEncoderThreads (encoderThreadsSelecter->value ());
+    opusBitrateSelecter->setValue (settings.at (4).toUShort ());
+    opusComplexitySelecter->setValue (settings.at (5).toUShort ());
+    setOpusSettings ();
+    resamplingQualitySelecter->setCurrentIndex (settings.at (6).toUShort ());
+    setResamplingQuality (resamplingQualitySelecter->currentIndex ());
+    FFTSizeSelecter->setCurrentIndex (settings.at (7).toUShort ());
+    overlapSelecter->setValue (settings.at (8).toUShort ());
+    bandCountSelecter->setValue (settings.at (9).toUShort ());
+    setAnalyzerSettings ();
+
+
+    connect (languageSelecter, SIGNAL (currentIndexChanged (int)), this, SLOT (promptToRestart ()));
+    connect (encoderThreadsSelecter, SIGNAL (valueChanged (int)), this, SLOT (setEncoderThreads (int)));
+    connect (opusBitrateSelecter, SIGNAL (valueChanged (int)), this, SLOT (setOpusSettings ()));
+    connect (opusComplexitySelecter, SIGNAL (valueChanged (int)), this, SLOT (setOpusSettings ()));
+    connect (resamplingQualitySelecter, SIGNAL (currentIndexChanged (int)), this, SLOT (setResamplingQuality (int)));
+    connect (FFTSizeSelecter, SIGNAL (currentIndexChanged (int)), this, SLOT (setAnalyzerSettings ()));
+    connect (overlapSelecter, SIGNAL (valueChanged (int)), this, SLOT (setAnalyzerSettings ()));
+    connect (bandCountSelecter, SIGNAL (valueChanged (int)), this, SLOT (setAnalyzerSettings ()));
+}
+
+
+OptionsWidget::~OptionsWidget ()
+{
+    std::ofstream settingsFile ("UI Options.pastouche");
+
+    if (settingsFile)
+    {
+        settingsFile<<languageSelecter->currentData ().toString ().toStdString ()<<"\n"
+                    <<languageSelecter->currentText ().toStdString ()<<"\n"
+                    <<themeSelecter->currentIndex ()<<"\n"
+                    <<encoderThreadsSelecter->value ()<<"\n"
+                    <<opusBitrateSelecter->value ()<<"\n"
+                    <<opusComplexitySelecter->value ()<<"\n"
+                    <<resamplingQualitySelecter->currentIndex ()<<"\n"
+                    <<FFTSizeSelecter->currentIndex ()<<"\n"
+                    <<overlapSelecter->value ()<<"\n"
+                    <<bandCountSelecter->value ();
+    }
+}
+
+
+////////////// Slots
+
+
+void OptionsWidget::changeTheme (int themeIndex)
+{
+    if (themeIndex == 0)
+    {
+        qApp->setStyle (QStyleFactory::create ("WindowsVista"));
+        qApp->setPalette (lightPalette);
+    }
+    else if (themeIndex == 1)
+    {
+        qApp->setStyle (QStyleFactory::create ("Fusion"));
+        qApp->setPalette (lightPalette);
+    }
+    else
+    {
+        qApp->setStyle (QStyleFactory::create ("Fusion"));
+        qApp->setPalette (darkPalette);
+    }
+
+    qApp->setFont (QFont ("Ubuntu"));
+}
+
+void OptionsWidget::setEncoderThreads (int threads)
+{
+    SoundFileWriters::setEncoderThreads (threads);
+}
+
+void OptionsWidget::setOpusSettings ()
+{
+    SoundFileWriters::setOpusSettings (opusBitrateSelecter->value () * 1000, opusComplexitySelecter->value ());
+}
+
+void OptionsWidget::setResamplingQuality (int quality)
+{
+    Resampler::setDefaultQuality (Resampler::Quality (quality));
+}
+
+void OptionsWidget::setAnalyzerSettings ()  // Applied at the next recording
+{
+    SpectrumAnalyzer::setDefaultSettings (FFTSizeSelecter->currentData ().toUInt (), overlapSelecter->value (), bandCountSelecter->value ());
+}
+
+void OptionsWidget::promptToRestart ()
+{
+    if (QMessageBox::question (this, tr("Language changed"), tr("You need to reload the application to apply changes.\nDo you want to restart now ?")) == QMessageBox::Yes)
+    {
+        qApp->quit ();
+        QProcess::startDetached (qApp->arguments ()[0], qApp->arguments ());
+    }
+}
+
+
+////////////// Others
+
+
+void OptionsWidget::initPalettes ()
+{
+    lightPalette = qApp->palette ();
+
+
+    darkPalette.setColor (QPalette::Window, QColor (53,53,53));
+    darkPalette.setColor (QPalette::WindowText, Qt::white);
+    darkPalette.setColor (QPalette::Disabled, QPalette::WindowText, QColor (127,127,127));
+    darkPalette.setColor (QPalette::Base, QColor (42,42,42));
+    darkPalette.setColor (QPalette::AlternateBase, QColor (66,66,66));
+    darkPalette.setColor (QPalette::ToolTipBase, Qt::white);
+    darkPalette.setColor (QPalette::ToolTipText, Qt::white);
+    darkPalette.setColor (QPalette::Text, Qt::white);
+    darkPalette.setColor (QPalette::Disabled, QPalette::Text, QColor (127,127,127));
+    darkPalette.setColor (QPalette::Dark, QColor (35,35,35));
+    darkPalette.setColor (QPalette::Shadow, QColor (20,20,20));
+    darkPalette.setColor (QPalette::Button, QColor (53,53,53));
+    darkPalette.setColor (QPalette::ButtonText, Qt::white);
+    darkPalette.setColor (QPalette::Disabled, QPalette::ButtonText, QColor (127,127,127));
+    darkPalette.setColor (QPalette::BrightText, Qt::red);
+    darkPalette.setColor (QPalette::Link, QColor (42,130,218));
+    darkPalette.setColor (QPalette::Highlight, QColor (42,130,218));
+    darkPalette.setColor (QPalette::Disabled, QPalette::Highlight, QColor (80,80,80));
+    darkPalette.setColor (QPalette::HighlightedText, Qt::white);
+    darkPalette.setColor (QPalette::Disabled, QPalette::HighlightedText, QColor (127,127,127));
+}
+
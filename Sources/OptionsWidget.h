@@ -1,58 +1,96 @@
-#ifndef OPTIONSWIDGET_H
-#define OPTIONSWIDGET_H
-
-
-#include <QApplication>
-
-#include <QComboBox>
-#include <QLabel>
-
-#include <QGroupBox>
-#include <QGridLayout>
-
-#include <QMessageBox>
-
-
-class OptionsWidget : public QWidget
-{
-    Q_OBJECT
-
-    public:
-        OptionsWidget ();
-        ~OptionsWidget ();
-
-
-    private slots:
-        void promptToRestart ();
-        void changeTheme (int);
-
-
-    private:
-        void initPalettes ();
-        void initOptionsBox ();
-
-        void loadOptions ();
-
-
-        QPalette lightPalette;
-        QPalette darkPalette;
-
-
-        QGridLayout* layout;
-
-        QLabel* aboutLabel;
-
-        QGroupBox* UIOptionsBox;
-        QGridLayout* UIOptionsBoxLayout;
-
-          QLabel* chooseLanguageLabel;
-          QComboBox* languageSelecter;
-
-          QLabel* chooseThemeLabel;
-          QComboBox* themeSelecter;
-
-        QLabel* NY4N_M4THS;
-};
-
-
-#endif // OPTIONSWIDGET_H
+#ifndef OPTIONSWIDGET_H
+#define OPTIONSWIDGET_H
+
+
+#include <QApplication>
+
+#include <QComboBox>
+#include <QLabel>
+#include <QSpinBox>
+
+#include <QGroupBox>
+#include <QGridLayout>
+
+#include <QMessageBox>
+
+
+class OptionsWidget : public QWidget
+{
+    Q_OBJECT
+
+    public:
+        OptionsWidget ();
+        ~OptionsWidget ();
+
+
+    private slots:
+        void promptToRestart ();
+        void changeTheme (int);
+        void setEncoderThreads (int);
+        void setOpusSettings ();
+        void setResamplingQuality (int);
+        void setAnalyzerSettings ();
+
+
+    private:
+        void initPalettes ();
+        void initOptionsBox ();
+        void initPerformanceBox ();
+        void initOpusBox ();
+        void initAnalyzerBox ();
+
+        void loadOptions ();
+
+
+        QPalette lightPalette;
+        QPalette darkPalette;
+
+
+        QGridLayout* layout;
+
+        QLabel* aboutLabel;
+
+        QGroupBox* UIOptionsBox;
+        QGridLayout* UIOptionsBoxLayout;
+
+          QLabel* chooseLanguageLabel;
+          QComboBox* languageSelecter;
+
+          QLabel* chooseThemeLabel;
+          QComboBox* themeSelecter;
+
+        QGroupBox* performanceBox;
+        QGridLayout* performanceBoxLayout;
+
+          QLabel* chooseEncoderThreadsLabel;
+          QSpinBox* encoderThreadsSelecter;
+
+          QLabel* chooseResamplingQualityLabel;
+          QComboBox* resamplingQualitySelecter;
+
+        QGroupBox* opusBox;
+        QGridLayout* opusBoxLayout;
+
+          QLabel* chooseOpusBitrateLabel;
+          QSpinBox* opusBitrateSelecter;
+
+          QLabel* chooseOpusComplexityLabel;
+          QSpinBox* opusComplexitySelecter;
+
+        QGroupBox* analyzerBox;
+        QGridLayout* analyzerBoxLayout;
+
+          QLabel* chooseFFTSizeLabel;
+          QComboBox* FFTSizeSelecter;
+
+          QLabel* chooseOverlapLabel;
+          QSpinBox* overlapSelecter;
+
+          QLabel* chooseBandCountLabel;
+          QSpinBox* bandCountSelecter;
+
+        QLabel* NY4N_M4THS;
+};
+
+
+#endif // OPTIONSWIDGET_H
@@ -1,515 +1,908 @@
-#include <QApplication>
-#include <QDateTime>
-
-#include <QFile>
-#include <fstream>
-#include <QStandardPaths>
-
-#include <QMessageBox>
-#include <QFileDialog>
-
-#include "RecorderWidget.h"
-
-
-////////////// Initialize widget
-
-
-RecorderWidget::RecorderWidget (QTabWidget* parent, RecordingsManagerWidget* displayTab) : QWidget ()
-{
-    recordingsTab = displayTab;
-    mainWindow = parent;
-
-    layout = new QGridLayout (this);
-
-
-    recorder = new AudioRecorder;
-
-    timer = new QTimer (this);
-    timer->setTimerType (Qt::PreciseTimer);
-    connect (timer, SIGNAL (timeout ()), this, SLOT (updateTimerLabel ()));
-
-    timerLabel = new QLabel (tr("Begin by clicking on \"Start recording\"..."));
-    timerLabel->setAlignment (Qt::AlignCenter);
-
-
-    initOptionsBox ();
-
-
-    initControlsBox ();
-
-
-    levelWidget = new AudioLevelWidget;
-    connect (recorder, SIGNAL (audioLevel (double)), levelWidget, SLOT (setLevel (double)));
-
-    spectrum = new SpectrumWidget;
-    connect (recorder, SIGNAL (audioLevel (double)), spectrum, SLOT (addLevel (double)));
-    connect (recorder, SIGNAL (started ()), spectrum, SLOT (clear ()));
-
-
-    layout->addWidget (optionsBox, 0, 0);
-    layout->addWidget (levelWidget, 0, 1);
-    layout->addWidget (filesOptionsWidget, 1, 0, 1, 2);
-    layout->addWidget (controlsWidget, 2, 0, 1, 2);
-    layout->addWidget (timerLabel, 3, 0, 1, 2);
-    layout->addWidget (spectrum, 4, 0, 1, 2);
-
-
-    loadOptions ();
-}
-
-void RecorderWidget::initOptionsBox ()
-{
-    optionsBox = new QGroupBox (tr("Options"));
-    optionsBoxLayout = new QGridLayout (optionsBox);
-    optionsBoxLayout->setSpacing (15);
-
-    initFilesOptionsBox ();
-
-    chooseDeviceLabel = new QLabel (tr("Choose microphone :"));
-    deviceSelecter = new DevicesComboBox;
-
-    chooseVolumeLabel = new QLabel;
-    volumeSelecter = new DirectJumpSlider;
-    volumeSelecter->setRange (0, 400);
-    connect (volumeSelecter, SIGNAL (valueChanged (int)), this, SLOT (setVolume (int)));
-
-    overamplificationWarning = new QLabel (tr("Values higher than 100% may degrade quality ! You don't need to change it if you have an ACG microphone."));
-    overamplificationWarning->setStyleSheet("QLabel{ color : red; font-style : italic; font-size : 13px; }");
-
-
-    initAdvancedOptionsBox ();
-
-
-    bResetCaptureSettings = new QPushButton (tr("Reset capture settings"));
-    connect (bResetCaptureSettings, SIGNAL (clicked ()), this, SLOT (resetCaptureSettings ()));
-
-    recorderImage = new QLabel;
-    recorderImage->setPixmap (QPixmap ("Recorder Image.png"));
-
-
-    optionsBoxLayout->addWidget (chooseDeviceLabel, 1, 0);
-    optionsBoxLayout->addWidget (deviceSelecter, 1, 1);
-    optionsBoxLayout->addWidget (chooseVolumeLabel, 2, 0);
-    optionsBoxLayout->addWidget (volumeSelecter, 2, 1);
-    optionsBoxLayout->addWidget (overamplificationWarning, 3, 0, 1, 3);
-
-    optionsBoxLayout->addWidget (advancedOptionsBox, 4, 0, 1, 2);
-
-    advancedOptionsBoxLayout->addWidget (chooseCodecLabel, 0, 0);
-    advancedOptionsBoxLayout->addWidget (codecSelecter, 0, 1);
-    advancedOptionsBoxLayout->addWidget (chooseRateLabel, 1, 0);
-    advancedOptionsBoxLayout->addWidget (rateSelecter, 1, 1);
-    advancedOptionsBoxLayout->addWidget (chooseChannelCountLabel, 2, 0);
-    advancedOptionsBoxLayout->addWidget (channelCountSelecter, 2, 1);
-
-    optionsBoxLayout->addWidget (bResetCaptureSettings, 5, 0);
-
-    optionsBoxLayout->addWidget (recorderImage, 4, 2);
-}
-
-void RecorderWidget::initFilesOptionsBox ()
-{
-    filesOptionsWidget = new QWidget;
-    filesOptionsWidgetLayout = new QGridLayout (filesOptionsWidget);
-
-
-    defaultDirLabel = new QLabel;
-    bChooseDefaultDir = new QPushButton (tr("Change"));
-    connect (bChooseDefaultDir, SIGNAL (clicked ()), this, SLOT (changeDefaultDir ()));
-
-    autoNameRecordings = new QCheckBox (tr("Give a default name to the recordings (date and time)"));
-
-
-    filesOptionsWidgetLayout->addWidget (defaultDirLabel, 0, 0);
-    filesOptionsWidgetLayout->addWidget (bChooseDefaultDir, 0, 1);
-    filesOptionsWidgetLayout->addWidget (autoNameRecordings, 1, 0, 1, 2);
-}
-
-void RecorderWidget::initAdvancedOptionsBox ()
-{
-    advancedOptionsBox = new QGroupBox (tr("Advanced coding options"));
-    advancedOptionsBox->setCheckable (true);
-    advancedOptionsBoxLayout = new QGridLayout (advancedOptionsBox);
-    advancedOptionsBoxLayout->setSpacing (15);
-    advancedOptionsBoxLayout->setAlignment (Qt::AlignLeft);
-
-    chooseCodecLabel = new QLabel (tr("Audio encoder :"));
-    codecSelecter = new QComboBox;
-
-    codecSelecter->addItem (tr("Vorbis (OGG) : compressed, good quality"), QVariant ("ogg"));
-    codecSelecter->addItem (tr("FLAC : compressed, best quality"), QVariant ("flac"));
-    codecSelecter->addItem (tr("PCM (WAV) : not compressed, best quality"), QVariant ("wav"));
-
-
-    chooseRateLabel = new QLabel (tr("Sample rate :"));
-    rateSelecter = new QComboBox;
-
-    std::ifstream datFile ("Rates.pastouche");
-    if (!datFile)
-        QMessageBox::critical (this, tr("Fatal error !"), tr("Impossible to load data files, please reinstall this app to fix this !"));
-
-    else
-    {
-        std::string displayItem, value;
-
-        while (getline (datFile, displayItem) && getline (datFile, value))
-            rateSelecter->addItem (QString::fromStdString (displayItem), QVariant (QString::fromStdString (value)));
-    }
-
-    chooseChannelCountLabel = new QLabel (tr("Channels :"));
-    channelCountSelecter = new QComboBox;
-    channelCountSelecter->addItem ("Mono (1)", QVariant (1));
-    channelCountSelecter->addItem (tr("Stereo (2)"), QVariant (2));
-}
-
-void RecorderWidget::initControlsBox ()
-{
-    controlsWidget = new QWidget;
-    controlsLayout = new QHBoxLayout (controlsWidget);
-
-
-    bStart = new QPushButton (QIcon ("Start button.png"), tr("Start &recording"));
-    bPause = new QPushButton (QIcon ("Pause button.png"), tr("&Pause recording"));
-    bStop = new QPushButton (QIcon ("Stop button.png"), tr("&Stop recording"));
-    bAbort = new QPushButton (QIcon ("Abort button.png"), tr("Stop without s&aving"));
-
-
-    connect (bStart, SIGNAL (clicked ()), this, SLOT (start ()));
-    connect (bPause, SIGNAL (clicked ()), this, SLOT (pause ()));
-    connect (bStop, SIGNAL (clicked ()), this, SLOT (stop ()));
-    connect (bAbort, SIGNAL (clicked ()), this, SLOT (abort ()));
-
-
-    bPause->setEnabled (false);
-    bStop->setEnabled (false);
-    bAbort->setEnabled (false);
-
-
-    controlsLayout->addWidget (bStart);
-    controlsLayout->addWidget (bPause);
-    controlsLayout->addWidget (bStop);
-    controlsLayout->addWidget (bAbort);
-}
-
-
-void RecorderWidget::loadOptions ()
-{
-    QStringList settings = {"0", "3", "1", "0", "100", "Invalid folder", "1"};
-
-
-    QFile settingsFile ("Recorder Options.pastouche");
-
-    if (settingsFile.open (QIODevice::ReadOnly | QIODevice::Text))
-    {
-        QStringList readSettings = QString (settingsFile.readAll ()).split ("\n");
-
-        if (readSettings.length () == settings.length ())
-            settings = readSettings;
-    }
-
-
-    if (!QFile::exists (settings.at (5)))
-        settings[5] = QStandardPaths::standardLocations (QStandardPaths::DocumentsLocation).at (0);
-
-    defaultDir = settings.at (5);
-    defaultDirLabel->setText (tr("Default directory : ") + defaultDir);
-
-    autoNameRecordings->setChecked (settings.at (6).toUShort ());
-    codecSelecter->setCurrentIndex (settings.at (0).toUShort ());
-    rateSelecter->setCurrentIndex (settings.at (1).toUShort ());
-    channelCountSelecter->setCurrentIndex (settings.at (2).toUShort ());
-    advancedOptionsBox->setChecked (settings.at (3).toUShort ());
-
-    volumeSelecter->setValue (settings.at (4).toUShort ());
-    setVolume (settings.at (4).toUShort ());
-}
-
-RecorderWidget::~RecorderWidget ()
-{
-    std::ofstream settingsFile ("Recorder Options.pastouche");
-
-    if (settingsFile)
-    {
-        settingsFile<<codecSelecter->currentIndex ()<<"\n"
-                    <<rateSelecter->currentIndex ()<<"\n"
-                    <<channelCountSelecter->currentIndex ()<<"\n"
-                    <<advancedOptionsBox->isChecked ()<<"\n"
-                    <<volumeSelecter->value ()<<"\n"
-                    <<defaultDir.toStdString ()<<"\n"
-                    <<autoNameRecordings->isChecked ();
-    }
-}
-
-
-////////////// Slots
-
-
-void RecorderWidget::changeDefaultDir ()
-{
-    QString newDir = QFileDialog::getExistingDirectory (this, tr("Choose the new recordings directory"), "", QFileDialog::ShowDirsOnly | QFileDialog::DontUseNativeDialog);
-
-    if (!newDir.isEmpty ())
-    {
-        defaultDir = newDir;
-        defaultDirLabel->setText (tr("Default directory : ") + newDir);
-    }
-}
-
-void RecorderWidget::setVolume (int newVolume)
-{
-    recorder->setVolume (newVolume);
-
-    chooseVolumeLabel->setText (tr("Input volume (") + QString::number (newVolume) + "%)");
-}
-
-void RecorderWidget::resetCaptureSettings ()
-{
-    if (QMessageBox::question (this, tr("Confirmation"), tr("Do you really want to reset these setings ?")) == QMessageBox::Yes)
-    {
-        deviceSelecter->setCurrentText (QString::fromStdString (sf::SoundRecorder::getAvailableDevices ().at (0)));
-
-        volumeSelecter->setValue (100);
-        codecSelecter->setCurrentIndex (0);
-        rateSelecter->setCurrentIndex (3);
-        channelCountSelecter->setCurrentIndex (1);
-    }
-}
-
-
-void RecorderWidget::updateTimerLabel ()
-{
-    unsigned int seconds = recorder->durationAsMilliseconds ();
-    unsigned int minutes = seconds / 60;
-    seconds %= 60;
-
-    if (!minutes)
-        timerLabel->setText (seconds == 1 ? tr("Recording time : 1 second") : tr("Recording time : %n seconds", "", seconds));
-
-    else if (seconds)
-        timerLabel->setText ((minutes == 1 ? tr("Recording time : 1 minute ") : tr("Recording time : %n minutes ", "", minutes)) +
-                             (seconds == 1 ? tr("and 1 second") : tr("and %n seconds", "", seconds)));
-
-    else
-        timerLabel->setText (minutes == 1 ? tr("Recording time : 1 minute") : tr("Recording time : %n minutes", "", minutes));
-}
-
-
-bool RecorderWidget::getFileInfos (unsigned int& sampleRate, unsigned short int& channelCount)
-{
-    QString codec ("ogg");
-
-    if (advancedOptionsBox->isChecked ())
-    {
-        codec = codecSelecter->currentData ().toString ();
-        sampleRate = rateSelecter->currentData ().toUInt ();
-        channelCount = channelCountSelecter->currentData ().toUInt ();
-    }
-
-    if (autoNameRecordings->isChecked ())
-        outputFileName = defaultDir + "/" + QDateTime::currentDateTime ().toString ().replace (":", ".");
-
-    else
-        outputFileName = QFileDialog::getSaveFileName (this, tr("Choose output file"), defaultDir, tr("Audio files (*.") + codec + ")", nullptr, QFileDialog::DontConfirmOverwrite | QFileDialog::DontUseNativeDialog);
-
-
-    if (outputFileName.isEmpty ())
-        return false;
-
-    if (!outputFileName.contains (QRegExp ("\\." + codec + "$", Qt::CaseInsensitive)))
-        outputFileName += "." + codec;
-
-
-    if (QFile::exists (outputFileName))
-    {
-        if (QMessageBox::question (this, tr("Wait a second !"), tr("This file already exists,\nDo you want to replace it ?")) == QMessageBox::No)
-        {
-            mainWindow->setWindowIcon (QIcon ("Window Icon.png"));
-            return false;
-        }
-        else
-            recordingsTab->removeCurrentFromList ();
-    }
-
-    return true;
-}
-
-void RecorderWidget::start ()
-{
-    if (recorder->paused ())
-    {
-        recorder->resume ();
-        timer->start (100);
-
-        bStart->setText (tr("Start &recording"));
-        mainWindow->setWindowIcon (QIcon ("Recording.png"));
-
-        bStart->setEnabled (false);
-        bPause->setEnabled (true);
-    }
-    else
-    {
-        unsigned int sampleRate = 44100;
-        unsigned short int channelCount = 2;
-
-        if (getFileInfos (sampleRate, channelCount))
-        {
-            recorder->setOutputStream (std::string (outputFileName.toLocal8Bit ()), sampleRate, channelCount);
-            recorder->setDevice (deviceSelecter->currentText ().toStdString ());
-            recorder->setChannelCount (channelCount);
-
-            recorder->start (sampleRate);
-            timer->start (100);
-
-
-            mainWindow->setWindowIcon (QIcon ("Recording.png"));
-
-            bStart->setEnabled (false);
-            bPause->setEnabled (true);
-            bStop->setEnabled (true);
-            bAbort->setEnabled (true);
-
-            optionsBox->setEnabled (false);
-        }
-    }
-}
-
-
-void RecorderWidget::pause ()
-{
-    recorder->pause ();
-    timer->stop ();
-
-
-    bStart->setText (tr("&Resume recording"));
-    mainWindow->setWindowIcon (QIcon ("Paused.png"));
-
-    bStart->setEnabled (true);
-    bPause->setEnabled (false);
-}
-
-
-void RecorderWidget::stop ()
-{
-    bool wasPaused = recorder->paused ();
-
-    recorder->pause ();
-    mainWindow->setWindowIcon (QIcon ("Paused.png"));
-
-
-    if (QMessageBox::question (this, tr("Confirmation"), tr("Do you really want to stop recording ?")) == QMessageBox::Yes)
-    {
-        timer->stop ();
-        recorder->stop ();
-        recordingsTab->addRecording (outputFileName);
-
-
-        bStart->setText (tr("Start &recording"));
-        mainWindow->setWindowIcon (QIcon ("Window Icon.png"));
-
-        optionsBox->setEnabled (true);
-
-        bStart->setEnabled (true);
-        bPause->setEnabled (false);
-        bStop->setEnabled (false);
-        bAbort->setEnabled (false);
-    }
-    else
-    {
-        if (wasPaused)
-            mainWindow->setWindowIcon (QIcon ("Paused.png"));
-
-        else
-        {
-            recorder->resume ();
-            mainWindow->setWindowIcon (QIcon ("Recording.png"));
-        }
-    }
-}
-
-
-void RecorderWidget::abort ()
-{
-    bool wasPaused = recorder->paused ();
-
-    recorder->pause ();
-    mainWindow->setWindowIcon (QIcon ("Paused.png"));
-
-
-    if (QMessageBox::question (this, tr("Beware !"), tr("Do you really want to abort recording ?")) == QMessageBox::Yes)
-    {
-        timer->stop ();
-        recorder->stop ();
-
-        QFile::remove (outputFileName);
-
-
-        bStart->setText (tr("Start &recording"));
-        mainWindow->setWindowIcon (QIcon ("Window Icon.png"));
-
-        optionsBox->setEnabled (true);
-
-        bStart->setEnabled (true);
-        bPause->setEnabled (false);
-        bStop->setEnabled (false);
-        bAbort->setEnabled (false);
-    }
-    else
-    {
-        if (wasPaused)
-            mainWindow->setWindowIcon (QIcon ("Paused.png"));
-
-        else
-        {
-            recorder->resume ();
-            mainWindow->setWindowIcon (QIcon ("Recording.png"));
-        }
-    }
-}
-
-
-// If the user closed the app during recording, prompt him/her to save or abort
-
-bool RecorderWidget::beforeExit ()
-{
-    if (recorder->recording ())
-    {
-        bool wasPaused = recorder->paused ();
-
-        recorder->pause ();
-        mainWindow->setWindowIcon (QIcon ("Paused.png"));
-
-
-        QMessageBox::StandardButton answer = QMessageBox::question (this, tr("Wait a second !"), tr("It seems you are still recording,\nDo you want to save before close ?"), QMessageBox::Yes | QMessageBox::No | QMessageBox::Cancel);
-
-        if (answer == QMessageBox::Yes)
-        {
-            recorder->stop ();
-            recordingsTab->addRecording (outputFileName);
-
-            return true;
-        }
-        else if (answer == QMessageBox::No)
-        {
-            recorder->stop ();
-
-            QFile::remove (outputFileName);
-
-            return true;
-        }
-        else
-        {
-            if (wasPaused)
-                mainWindow->setWindowIcon (QIcon ("Paused.png"));
-
-            else
-            {
-                recorder->resume ();
-                mainWindow->setWindowIcon (QIcon ("Recording.png"));
-            }
-
-            return false;
-        }
-    }
-
-    return true;
-}
+#include <QApplication>
+#include <QDateTime>
+
+#include <QFile>
+#include <fstream>
+#include <QStandardPaths>
+
+#include <QMessageBox>
+#include <QFileDialog>
+
+#include "RecorderWidget.h"
+
+
+////////////// Initialize widget
+
+
+RecorderWidget::RecorderWidget (QTabWidget* parent, RecordingsManagerWidget* displayTab) : QWidget ()
+{
+    recordingsTab = displayTab;
+    mainWindow = parent;
+
+    layout = new QGridLayout (this);
+
+
+    session = new RecordingSession (this);
+    session->setSpectrumAnalysis (true);
+    connect (session, SIGNAL (segmentCompleted (QString)), recordingsTab, SLOT (addRecording (QString)));
+
+    timer = new QTimer (this);
+    timer->setTimerType (Qt::PreciseTimer);
+    connect (timer, SIGNAL (timeout ()), this, SLOT (updateTimerLabel ()));
+
+    levelsTimer = new QTimer (this);
+    levelsTimer->setTimerType (Qt::PreciseTimer);
+    connect (levelsTimer, SIGNAL (timeout ()), this, SLOT (updateLevels ()));
+    levelsVersion = 0;
+    spectrumVersion = 0;
+    spectrumColumns.resize (SpectrumBands::maxBands * 32);
+
+    timerLabel = new QLabel (tr("Begin by clicking on \"Start recording\"..."));
+    timerLabel->setAlignment (Qt::AlignCenter);
+
+    captureStatsLabel = new QLabel;
+    captureStatsLabel->setAlignment (Qt::AlignCenter);
+    captureStatsLabel->setStyleSheet ("QLabel{ font-style : italic; font-size : 13px; }");
+
+    timingsLabel = new QLabel;
+    timingsLabel->setAlignment (Qt::AlignCenter);
+    timingsLabel->setStyleSheet ("QLabel{ font-style : italic; font-size : 13px; }");
+    timingsLabel->setToolTip (tr("Full histograms are written in \"Capture log.txt\" at the end of each recording"));
+
+
+    initOptionsBox ();
+
+
+    initControlsBox ();
+
+
+    levelWidget = new AudioLevelWidget;
+
+    spectrum = new SpectrumWidget;
+    connect (session, SIGNAL (started ()), spectrum, SLOT (clear ()));
+
+    analyzer = new SpectrumAnalyzerWidget;
+    connect (session, SIGNAL (started ()), analyzer, SLOT (clear ()));
+
+
+    layout->addWidget (optionsBox, 0, 0);
+    layout->addWidget (levelWidget, 0, 1);
+    layout->addWidget (filesOptionsWidget, 1, 0, 1, 2);
+    layout->addWidget (controlsWidget, 2, 0, 1, 2);
+    layout->addWidget (timerLabel, 3, 0, 1, 2);
+    layout->addWidget (spectrum, 4, 0, 1, 2);
+    layout->addWidget (analyzer, 5, 0, 1, 2);
+    layout->addWidget (captureStatsLabel, 6, 0, 1, 2);
+    layout->addWidget (timingsLabel, 7, 0, 1, 2);
+
+
+    loadOptions ();
+}
+
+void RecorderWidget::initOptionsBox ()
+{
+    optionsBox = new QGroupBox (tr("Options"));
+    optionsBoxLayout = new QGridLayout (optionsBox);
+    optionsBoxLayout->setSpacing (15);
+
+    initFilesOptionsBox ();
+
+    chooseDeviceLabel = new QLabel (tr("Choose microphone :"));
+    deviceSelecter = new DevicesComboBox;
+
+    extraDevicesMenu = new QMenu (this);
+    connect (extraDevicesMenu, SIGNAL (aboutToShow ()), this, SLOT (updateExtraDevicesMenu ()));
+    connect (extraDevicesMenu, SIGNAL (triggered (QAction*)), this, SLOT (toggleExtraDevice (QAction*)));
+
+    bExtraDevices = new QPushButton (tr("Also record from..."));
+    bExtraDevices->setMenu (extraDevicesMenu);
+
+    chooseVolumeLabel = new QLabel;
+    volumeSelecter = new DirectJumpSlider;
+    volumeSelecter->setRange (0, 400);
+    connect (volumeSelecter, SIGNAL (valueChanged (int)), this, SLOT (setVolume (int)));
+
+    overamplificationWarning = new QLabel (tr("Values higher than 100% may degrade quality ! You don't need to change it if you have an ACG microphone."));
+    overamplificationWarning->setStyleSheet("QLabel{ color : red; font-style : italic; font-size : 13px; }");
+
+
+    initAdvancedOptionsBox ();
+
+
+    bResetCaptureSettings = new QPushButton (tr("Reset capture settings"));
+    connect (bResetCaptureSettings, SIGNAL (clicked ()), this, SLOT (resetCaptureSettings ()));
+
+    recorderImage = new QLabel;
+    recorderImage->setPixmap (QPixmap ("Recorder Image.png"));
+
+
+    optionsBoxLayout->addWidget (chooseDeviceLabel, 1, 0);
+    optionsBoxLayout->addWidget (deviceSelecter, 1, 1);
+    optionsBoxLayout->addWidget (bExtraDevices, 1, 2);
+    optionsBoxLayout->addWidget (chooseVolumeLabel, 2, 0);
+    optionsBoxLayout->addWidget (volumeSelecter, 2, 1);
+    optionsBoxLayout->addWidget (overamplificationWarning, 3, 0, 1, 3);
+
+    optionsBoxLayout->addWidget (advancedOptionsBox, 4, 0, 1, 2);
+
+    advancedOptionsBoxLayout->addWidget (chooseCodecLabel, 0, 0);
+    advancedOptionsBoxLayout->addWidget (codecSelecter, 0, 1);
+    advancedOptionsBoxLayout->addWidget (chooseRateLabel, 1, 0);
+    advancedOptionsBoxLayout->addWidget (rateSelecter, 1, 1);
+    advancedOptionsBoxLayout->addWidget (chooseChannelCountLabel, 2, 0);
+    advancedOptionsBoxLayout->addWidget (channelCountSelecter, 2, 1);
+    advancedOptionsBoxLayout->addWidget (chooseLatencyLabel, 3, 0);
+    advancedOptionsBoxLayout->addWidget (latencySelecter, 3, 1);
+    advancedOptionsBoxLayout->addWidget (chooseBufferDurationLabel, 4, 0);
+    advancedOptionsBoxLayout->addWidget (bufferDurationSelecter, 4, 1);
+    advancedOptionsBoxLayout->addWidget (chooseMultiDeviceModeLabel, 5, 0);
+    advancedOptionsBoxLayout->addWidget (multiDeviceModeSelecter, 5, 1);
+    advancedOptionsBoxLayout->addWidget (choosePreRollLabel, 6, 0);
+    advancedOptionsBoxLayout->addWidget (preRollSelecter, 6, 1);
+    advancedOptionsBoxLayout->addWidget (chooseSilenceThresholdLabel, 7, 0);
+    advancedOptionsBoxLayout->addWidget (silenceThresholdSelecter, 7, 1);
+    advancedOptionsBoxLayout->addWidget (chooseSilenceHangoverLabel, 8, 0);
+    advancedOptionsBoxLayout->addWidget (silenceHangoverSelecter, 8, 1);
+    advancedOptionsBoxLayout->addWidget (chooseSegmentDurationLabel, 9, 0);
+    advancedOptionsBoxLayout->addWidget (segmentDurationSelecter, 9, 1);
+    advancedOptionsBoxLayout->addWidget (chooseSegmentSizeLabel, 10, 0);
+    advancedOptionsBoxLayout->addWidget (segmentSizeSelecter, 10, 1);
+    advancedOptionsBoxLayout->addWidget (chooseOverloadProtectionLabel, 11, 0);
+    advancedOptionsBoxLayout->addWidget (overloadProtectionSelecter, 11, 1);
+    advancedOptionsBoxLayout->addWidget (chooseMemoryBudgetLabel, 12, 0);
+    advancedOptionsBoxLayout->addWidget (memoryBudgetSelecter, 12, 1);
+    advancedOptionsBoxLayout->addWidget (chooseCaptureRateLabel, 13, 0);
+    advancedOptionsBoxLayout->addWidget (captureRateSelecter, 13, 1);
+
+    optionsBoxLayout->addWidget (bResetCaptureSettings, 5, 0);
+
+    optionsBoxLayout->addWidget (recorderImage, 4, 2);
+}
+
+void RecorderWidget::initFilesOptionsBox ()
+{
+    filesOptionsWidget = new QWidget;
+    filesOptionsWidgetLayout = new QGridLayout (filesOptionsWidget);
+
+
+    defaultDirLabel = new QLabel;
+    bChooseDefaultDir = new QPushButton (tr("Change"));
+    connect (bChooseDefaultDir, SIGNAL (clicked ()), this, SLOT (changeDefaultDir ()));
+
+    autoNameRecordings = new QCheckBox (tr("Give a default name to the recordings (date and time)"));
+
+
+    filesOptionsWidgetLayout->addWidget (defaultDirLabel, 0, 0);
+    filesOptionsWidgetLayout->addWidget (bChooseDefaultDir, 0, 1);
+    filesOptionsWidgetLayout->addWidget (autoNameRecordings, 1, 0, 1, 2);
+}
+
+void RecorderWidget::initAdvancedOptionsBox ()
+{
+    advancedOptionsBox = new QGroupBox (tr("Advanced coding options"));
+    advancedOptionsBox->setCheckable (true);
+    advancedOptionsBoxLayout = new QGridLayout (advancedOptionsBox);
+    advancedOptionsBoxLayout->setSpacing (15);
+    advancedOptionsBoxLayout->setAlignment (Qt::AlignLeft);
+
+    chooseCodecLabel = new QLabel (tr("Audio encoder :"));
+    codecSelecter = new QComboBox;
+
+    codecSelecter->addItem (tr("Vorbis (OGG) : compressed, good quality"), QVariant ("ogg"));
+    codecSelecter->addItem (tr("FLAC : compressed, best quality"), QVariant ("flac"));
+    codecSelecter->addItem (tr("PCM (WAV) : not compressed, best quality"), QVariant ("wav"));
+    codecSelecter->addItem (tr("Opus : compressed, smallest files"), QVariant ("opus"));
+
+
+    chooseRateLabel = new QLabel (tr("Sample rate :"));
+    rateSelecter = new QComboBox;
+
+    std::ifstream datFile ("Rates.pastouche");
+    if (!datFile)
+        QMessageBox::critical (this, tr("Fatal error !"), tr("Impossible to load data files, please reinstall this app to fix this !"));
+
+    else
+    {
+        std::string displayItem, value;
+
+        while (getline (datFile, displayItem) && getline (datFile, value))
+            rateSelecter->addItem (QString::fromStdString (displayItem), QVariant (QString::fromStdString (value)));
+    }
+
+    chooseChannelCountLabel = new QLabel (tr("Channels :"));
+    channelCountSelecter = new QComboBox;
+    channelCountSelecter->addItem ("Mono (1)", QVariant (1));
+    channelCountSelecter->addItem (tr("Stereo (2)"), QVariant (2));
+
+    chooseLatencyLabel = new QLabel (tr("Latency profile :"));
+    latencySelecter = new QComboBox;
+    latencySelecter->addItem (tr("Low latency (5 ms)"), QVariant (5));
+    latencySelecter->addItem (tr("Balanced (20 ms)"), QVariant (20));
+    latencySelecter->addItem (tr("Throughput (100 ms)"), QVariant (100));
+    latencySelecter->addItem (tr("Max throughput (250 ms)"), QVariant (250));
+    latencySelecter->setToolTip (tr("Longer capture blocks wake the recorder up less often and use less CPU"));
+
+    chooseBufferDurationLabel = new QLabel (tr("Write buffer :"));
+    bufferDurationSelecter = new QSpinBox;
+    bufferDurationSelecter->setRange (100, 30000);
+    bufferDurationSelecter->setSingleStep (100);
+    bufferDurationSelecter->setSuffix (" ms");
+    bufferDurationSelecter->setToolTip (tr("Audio kept in memory while the encoder catches up, raise it if you get dropouts"));
+
+    chooseMultiDeviceModeLabel = new QLabel (tr("Several microphones :"));
+    multiDeviceModeSelecter = new QComboBox;
+    multiDeviceModeSelecter->addItem (tr("One file per microphone"));
+    multiDeviceModeSelecter->addItem (tr("One multichannel file"));
+
+    choosePreRollLabel = new QLabel (tr("Pre-roll :"));
+    preRollSelecter = new QSpinBox;
+    preRollSelecter->setRange (0, 60);
+    preRollSelecter->setSuffix (tr(" s before start"));
+    preRollSelecter->setSpecialValueText (tr("Disabled"));
+    preRollSelecter->setToolTip (tr("The microphone is kept open and the last seconds are added at the beginning of the recording"));
+
+    chooseSilenceThresholdLabel = new QLabel (tr("Skip silences :"));
+    silenceThresholdSelecter = new QSpinBox;
+    silenceThresholdSelecter->setRange (-80, -10);
+    silenceThresholdSelecter->setPrefix (tr("Below "));
+    silenceThresholdSelecter->setSuffix (" dB");
+    silenceThresholdSelecter->setSpecialValueText (tr("Disabled"));
+    silenceThresholdSelecter->setToolTip (tr("Quiet passages are not written, their position is saved in a \".silences.txt\" file next to the recording"));
+
+    chooseSilenceHangoverLabel = new QLabel (tr("Silence before skipping :"));
+    silenceHangoverSelecter = new QSpinBox;
+    silenceHangoverSelecter->setRange (100, 30000);
+    silenceHangoverSelecter->setSingleStep (100);
+    silenceHangoverSelecter->setSuffix (" ms");
+
+    chooseSegmentDurationLabel = new QLabel (tr("New file every :"));
+    segmentDurationSelecter = new QSpinBox;
+    segmentDurationSelecter->setRange (0, 1440);
+    segmentDurationSelecter->setSingleStep (5);
+    segmentDurationSelecter->setSuffix (tr(" min"));
+    segmentDurationSelecter->setSpecialValueText (tr("Never"));
+    segmentDurationSelecter->setToolTip (tr("Long recordings are split in several files, a crash can only damage the last one"));
+
+    chooseSegmentSizeLabel = new QLabel (tr("New file above :"));
+    segmentSizeSelecter = new QSpinBox;
+    segmentSizeSelecter->setRange (0, 65536);
+    segmentSizeSelecter->setSingleStep (256);
+    segmentSizeSelecter->setSuffix (tr(" MB"));
+    segmentSizeSelecter->setSpecialValueText (tr("No limit"));
+
+    chooseOverloadProtectionLabel = new QLabel (tr("Too loud sounds :"));
+    overloadProtectionSelecter = new QComboBox;
+    overloadProtectionSelecter->addItem (tr("Clip them"));
+    overloadProtectionSelecter->addItem (tr("Limit them"));
+    overloadProtectionSelecter->addItem (tr("Limit them and adjust the volume"));
+    overloadProtectionSelecter->setToolTip (tr("The limiter lowers the volume just before the peaks instead of cutting them, it delays the audio of 5 ms"));
+
+    chooseMemoryBudgetLabel = new QLabel (tr("Record to memory first :"));
+    memoryBudgetSelecter = new QSpinBox;
+    memoryBudgetSelecter->setRange (0, 4096);
+    memoryBudgetSelecter->setSingleStep (64);
+    memoryBudgetSelecter->setSuffix (tr(" MB"));
+    memoryBudgetSelecter->setSpecialValueText (tr("No, write directly"));
+    memoryBudgetSelecter->setToolTip (tr("For slow or network disks : audio waits in memory and is written by large blocks,\n"
+                                         "if the disk stalls until this memory is full, the newest audio is replaced by silence"));
+
+    chooseCaptureRateLabel = new QLabel (tr("Device rate :"));
+    captureRateSelecter = new QComboBox;
+    captureRateSelecter->addItem (tr("Same as the file"), QVariant (0));
+
+    for (int i = 0 ; i != rateSelecter->count () ; i++)
+        captureRateSelecter->addItem (rateSelecter->itemText (i), rateSelecter->itemData (i));
+
+    captureRateSelecter->setToolTip (tr("Rate asked to the microphones, choose their native one to avoid the resampling of the driver,\n"
+                                        "the audio is then converted to the file rate with the quality chosen in the options"));
+}
+
+void RecorderWidget::initControlsBox ()
+{
+    controlsWidget = new QWidget;
+    controlsLayout = new QHBoxLayout (controlsWidget);
+
+
+    bStart = new QPushButton (QIcon ("Start button.png"), tr("Start &recording"));
+    bPause = new QPushButton (QIcon ("Pause button.png"), tr("&Pause recording"));
+    bStop = new QPushButton (QIcon ("Stop button.png"), tr("&Stop recording"));
+    bAbort = new QPushButton (QIcon ("Abort button.png"), tr("Stop without s&aving"));
+
+
+    connect (bStart, SIGNAL (clicked ()), this, SLOT (start ()));
+    connect (bPause, SIGNAL (clicked ()), this, SLOT (pause ()));
+    connect (bStop, SIGNAL (clicked ()), this, SLOT (stop ()));
+    connect (bAbort, SIGNAL (clicked ()), this, SLOT (abort ()));
+
+
+    bPause->setEnabled (false);
+    bStop->setEnabled (false);
+    bAbort->setEnabled (false);
+
+
+    controlsLayout->addWidget (bStart);
+    controlsLayout->addWidget (bPause);
+    controlsLayout->addWidget (bStop);
+    controlsLayout->addWidget (bAbort);
+}
+
+
+void RecorderWidget::loadOptions ()
+{
+    QStringList settings = {"0", "3", "1", "0", "100", "Invalid folder", "1", "2000", "1", "0", "0", "-80", "2000", "0", "0", "0", "0", "0", "0"};
+
+
+    QFile settingsFile ("Recorder Options.pastouche");
+
+    if (settingsFile.open (QIODevice::ReadOnly | QIODevice::Text))
+    {
+        QStringList readSettings = QString (settingsFile.readAll ()).split ("\n");
+
+        if (readSettings.length () == settings.length ())
+            settings = readSettings;
+    }
+
+
+    if (!QFile::exists (settings.at (5)))
+        settings[5] = QStandardPaths::standardLocations (QStandardPaths::DocumentsLocation).at (0);
+
+    defaultDir = settings.at (5);
+    defaultDirLabel->setText (tr("Default directory : ") + defaultDir);
+
+    autoNameRecordings->setChecked (settings.at (6).toUShort ());
+    codecSelecter->setCurrentIndex (settings.at (0).toUShort ());
+    rateSelecter->setCurrentIndex (settings.at (1).toUShort ());
+    channelCountSelecter->setCurrentIndex (settings.at (2).toUShort ());
+    advancedOptionsBox->setChecked (settings.at (3).toUShort ());
+    bufferDurationSelecter->setValue (settings.at (7).toUInt ());
+    latencySelecter->setCurrentIndex (settings.at (8).toUShort ());
+    multiDeviceModeSelecter->setCurrentIndex (settings.at (9).toUShort ());
+    preRollSelecter->setValue (settings.at (10).toUShort ());
+    silenceThresholdSelecter->setValue (settings.at (11).toInt ());
+    silenceHangoverSelecter->setValue (settings.at (12).toUInt ());
+    segmentDurationSelecter->setValue (settings.at (13).toUInt ());
+    segmentSizeSelecter->setValue (settings.at (14).toUInt ());
+    overloadProtectionSelecter->setCurrentIndex (settings.at (15).toUShort ());
+    memoryBudgetSelecter->setValue (settings.at (16).toUInt ());
+    captureRateSelecter->setCurrentIndex (settings.at (17).toUShort ());
+    analyzer->setMode (SpectrumAnalyzerWidget::Mode (settings.at (18).toUShort ()));
+
+    volumeSelecter->setValue (settings.at (4).toUShort ());
+    setVolume (settings.at (4).toUShort ());
+
+
+    connect (deviceSelecter, SIGNAL (currentIndexChanged (int)), this, SLOT (updateMonitoring ()));
+    connect (rateSelecter, SIGNAL (currentIndexChanged (int)), this, SLOT (updateMonitoring ()));
+    connect (captureRateSelecter, SIGNAL (currentIndexChanged (int)), this, SLOT (updateMonitoring ()));
+    connect (channelCountSelecter, SIGNAL (currentIndexChanged (int)), this, SLOT (updateMonitoring ()));
+    connect (latencySelecter, SIGNAL (currentIndexChanged (int)), this, SLOT (updateMonitoring ()));
+    connect (preRollSelecter, SIGNAL (valueChanged (int)), this, SLOT (updateMonitoring ()));
+    connect (overloadProtectionSelecter, SIGNAL (currentIndexChanged (int)), this, SLOT (updateMonitoring ()));
+    connect (advancedOptionsBox, SIGNAL (toggled (bool)), this, SLOT (updateMonitoring ()));
+
+    updateMonitoring ();
+}
+
+RecorderWidget::~RecorderWidget ()
+{
+    std::ofstream settingsFile ("Recorder Options.pastouche");
+
+    if (settingsFile)
+    {
+        settingsFile<<codecSelecter->currentIndex ()<<"\n"
+                    <<rateSelecter->currentIndex ()<<"\n"
+                    <<channelCountSelecter->currentIndex ()<<"\n"
+                    <<advancedOptionsBox->isChecked ()<<"\n"
+                    <<volumeSelecter->value ()<<"\n"
+                    <<defaultDir.toStdString ()<<"\n"
+                    <<autoNameRecordings->isChecked ()<<"\n"
+                    <<bufferDurationSelecter->value ()<<"\n"
+                    <<latencySelecter->currentIndex ()<<"\n"
+                    <<multiDeviceModeSelecter->currentIndex ()<<"\n"
+                    <<preRollSelecter->value ()<<"\n"
+                    <<silenceThresholdSelecter->value ()<<"\n"
+                    <<silenceHangoverSelecter->value ()<<"\n"
+                    <<segmentDurationSelecter->value ()<<"\n"
+                    <<segmentSizeSelecter->value ()<<"\n"
+                    <<overloadProtectionSelecter->currentIndex ()<<"\n"
+                    <<memoryBudgetSelecter->value ()<<"\n"
+                    <<captureRateSelecter->currentIndex ()<<"\n"
+                    <<analyzer->mode ();
+    }
+}
+
+
+////////////// Slots
+
+
+void RecorderWidget::changeDefaultDir ()
+{
+    QString newDir = QFileDialog::getExistingDirectory (this, tr("Choose the new recordings directory"), "", QFileDialog::ShowDirsOnly | QFileDialog::DontUseNativeDialog);
+
+    if (!newDir.isEmpty ())
+    {
+        defaultDir = newDir;
+        defaultDirLabel->setText (tr("Default directory : ") + newDir);
+    }
+}
+
+void RecorderWidget::updateExtraDevicesMenu ()
+{
+    extraDevicesMenu->clear ();
+
+    std::vector<std::string> devices = sf::SoundRecorder::getAvailableDevices ();
+
+    for (unsigned short int i = 0 ; i != devices.size () ; i++)
+    {
+        QString device (QString::fromStdString (devices.at (i)));
+
+        if (device != deviceSelecter->currentText ())
+        {
+            QAction* deviceAction = extraDevicesMenu->addAction (device);
+
+            deviceAction->setCheckable (true);
+            deviceAction->setChecked (extraDevices.contains (device));
+        }
+    }
+
+    if (extraDevicesMenu->isEmpty ())
+        extraDevicesMenu->addAction (tr("No other microphone found"))->setEnabled (false);
+}
+
+void RecorderWidget::toggleExtraDevice (QAction* deviceAction)
+{
+    if (deviceAction->isChecked ())
+        extraDevices += deviceAction->text ();
+
+    else
+        extraDevices.removeAll (deviceAction->text ());
+
+
+    bExtraDevices->setText (extraDevices.isEmpty () ? tr("Also record from...") : tr("Also record from %n other(s)", "", extraDevices.length ()));
+
+    updateMonitoring ();
+}
+
+void RecorderWidget::updateMonitoring ()  // Keep the microphones open for the pre-roll, with the format of the next recording
+{
+    if (session->recording ())
+        return;
+
+    session->stop ();
+
+    if (preRollSelecter->value () != 0)
+    {
+        unsigned int sampleRate;
+        unsigned short int channelCount;
+
+        getCaptureFormat (sampleRate, channelCount);
+
+        session->setDevices (selectedDevices ());
+        session->setLatency (latencySelecter->currentData ().toUInt ());
+        session->setPreRoll (preRollSelecter->value () * 1000);
+        session->setOverloadProtection (AudioRecorder::OverloadProtection (overloadProtectionSelecter->currentIndex ()));
+        session->setCaptureRate (advancedOptionsBox->isChecked () ? captureRateSelecter->currentData ().toUInt () : 0);
+
+        session->monitor (sampleRate, channelCount);
+    }
+}
+
+
+void RecorderWidget::setVolume (int newVolume)
+{
+    session->setVolume (newVolume);
+
+    chooseVolumeLabel->setText (tr("Input volume (") + QString::number (newVolume) + "%)");
+}
+
+void RecorderWidget::resetCaptureSettings ()
+{
+    if (QMessageBox::question (this, tr("Confirmation"), tr("Do you really want to reset these setings ?")) == QMessageBox::Yes)
+    {
+        deviceSelecter->setCurrentText (QString::fromStdString (sf::SoundRecorder::getAvailableDevices ().at (0)));
+
+        volumeSelecter->setValue (100);
+        codecSelecter->setCurrentIndex (0);
+        rateSelecter->setCurrentIndex (3);
+        channelCountSelecter->setCurrentIndex (1);
+        bufferDurationSelecter->setValue (2000);
+        latencySelecter->setCurrentIndex (1);
+        multiDeviceModeSelecter->setCurrentIndex (0);
+        preRollSelecter->setValue (0);
+        silenceThresholdSelecter->setValue (-80);
+        silenceHangoverSelecter->setValue (2000);
+        segmentDurationSelecter->setValue (0);
+        segmentSizeSelecter->setValue (0);
+        overloadProtectionSelecter->setCurrentIndex (0);
+        memoryBudgetSelecter->setValue (0);
+        captureRateSelecter->setCurrentIndex (0);
+
+        extraDevices.clear ();
+        bExtraDevices->setText (tr("Also record from..."));
+
+        updateMonitoring ();
+    }
+}
+
+
+void RecorderWidget::updateTimerLabel ()
+{
+    unsigned int seconds = session->durationAsMilliseconds ();
+    unsigned int minutes = seconds / 60;
+    seconds %= 60;
+
+    if (!minutes)
+        timerLabel->setText (seconds == 1 ? tr("Recording time : 1 second") : tr("Recording time : %n seconds", "", seconds));
+
+    else if (seconds)
+        timerLabel->setText ((minutes == 1 ? tr("Recording time : 1 minute ") : tr("Recording time : %n minutes ", "", minutes)) +
+                             (seconds == 1 ? tr("and 1 second") : tr("and %n seconds", "", seconds)));
+
+    else
+        timerLabel->setText (minutes == 1 ? tr("Recording time : 1 minute") : tr("Recording time : %n minutes", "", minutes));
+
+
+    captureStatsLabel->setText (latencySelecter->currentText () + " : " +
+                                tr("%1 callbacks/s, %2 % CPU in capture").arg (session->mainRecorder ()->callbacksPerSecond (), 0, 'f', 1).arg (session->mainRecorder ()->processingLoad () * 100, 0, 'f', 2) +
+                                (memoryBudgetSelecter->value () != 0 ? tr(", %1 MB waiting in memory").arg (session->memoryUsed () / (1024 * 1024)) : QString ()));
+
+    const CaptureTimings& timings = session->mainRecorder ()->timings ();
+
+    timingsLabel->setText (tr("Callbacks : %1 ms max, jitter under %2 ms for 99 %, %n gap(s) in the audio", "", session->captureGaps ())
+                           .arg (timings.durations ().maximum () / 1000.0, 0, 'f', 2).arg (timings.jitter ().percentile (0.99) / 1000.0, 0, 'f', 1));
+}
+
+
+void RecorderWidget::addRecordings ()
+{
+    for (const std::string& fileName : session->outputFiles ())
+        recordingsTab->addRecording (QString::fromLocal8Bit (fileName.c_str ()));
+}
+
+void RecorderWidget::removeRecordings ()
+{
+    for (const std::string& fileName : session->outputFiles ())
+        QFile::remove (QString::fromLocal8Bit (fileName.c_str ()));
+}
+
+std::vector<std::string> RecorderWidget::selectedDevices ()  // Main device first, then the other checked ones still plugged in
+{
+    std::vector<std::string> devices ({deviceSelecter->currentText ().toStdString ()});
+    std::vector<std::string> availableDevices = sf::SoundRecorder::getAvailableDevices ();
+
+    for (unsigned short int i = 0 ; i != extraDevices.length () ; i++)
+    {
+        std::string device = extraDevices.at (i).toStdString ();
+
+        if (device != devices.at (0) && std::find (availableDevices.begin (), availableDevices.end (), device) != availableDevices.end ())
+            devices.push_back (device);
+    }
+
+    return devices;
+}
+
+
+void RecorderWidget::checkOverruns ()
+{
+    if (session->bufferOverruns ())
+        QMessageBox::warning (this, tr("Dropouts detected"), tr("The encoder could not keep up, %n audio blocks were lost.\nTry a bigger write buffer in the advanced options.", "", session->bufferOverruns ()));
+
+    if (session->droppedFrames ())
+        QMessageBox::warning (this, tr("Dropouts detected"), tr("The disk was too slow and the memory buffer got full, %1 seconds of audio were replaced by silence.\nTry a bigger memory buffer in the advanced options.")
+                                                             .arg (double (session->droppedFrames ()) / session->mainRecorder ()->getSampleRate (), 0, 'f', 1));
+}
+
+void RecorderWidget::updateLevels ()  // Pull the meters published by the capture thread at display rate
+{
+    if (!session->recording () || session->paused ())
+    {
+        levelWidget->setLevels (AudioLevels ());
+        spectrum->addLevels (AudioLevels ());
+        analyzer->setBands (SpectrumBands ());
+    }
+    else
+    {
+        unsigned int version;
+        AudioLevels levels = session->mainRecorder ()->levels (&version);
+
+        if (version != levelsVersion)
+        {
+            levelsVersion = version;
+
+            spectrum->addLevels (levels);
+        }
+
+        for (unsigned int i = 1 ; i < session->recordersCount () ; i++)  // One meter per channel of every microphone
+        {
+            AudioLevels inputLevels = session->recorder (i)->levels ();
+
+            for (unsigned short int channel = 0 ; channel != inputLevels.channelCount && levels.channelCount != AudioLevels::maxChannels ; channel++)
+                levels.channels[levels.channelCount++] = inputLevels.channels[channel];
+
+            levels.gainReduction = std::min (levels.gainReduction, inputLevels.gainReduction);
+        }
+
+        levelWidget->setLevels (levels);  // Repaints only the meters whose pixels changed
+
+        SpectrumBands bands = session->mainRecorder ()->spectrum (&version);
+
+        if (version != spectrumVersion)  // Only the bands, the analysis runs on its own thread
+        {
+            spectrumVersion = version;
+
+            analyzer->setBands (bands);
+        }
+
+        unsigned short int columnsBandCount;
+        std::size_t columnsCount = session->mainRecorder ()->spectrumColumns (&spectrumColumns[0], spectrumColumns.size (), columnsBandCount);
+
+        while (columnsCount != 0)  // Every window analyzed since the last refresh, the spectrogram must not miss any
+        {
+            analyzer->addColumns (&spectrumColumns[0], columnsCount, columnsBandCount);
+
+            columnsCount = session->mainRecorder ()->spectrumColumns (&spectrumColumns[0], spectrumColumns.size (), columnsBandCount);
+        }
+    }
+}
+
+
+void RecorderWidget::getCaptureFormat (unsigned int& sampleRate, unsigned short int& channelCount)
+{
+    sampleRate = 44100;
+    channelCount = 2;
+
+    if (advancedOptionsBox->isChecked ())
+    {
+        sampleRate = rateSelecter->currentData ().toUInt ();
+        channelCount = channelCountSelecter->currentData ().toUInt ();
+    }
+}
+
+bool RecorderWidget::getFileInfos (unsigned int& sampleRate, unsigned short int& channelCount)
+{
+    QString codec ("ogg");
+
+    if (advancedOptionsBox->isChecked ())
+        codec = codecSelecter->currentData ().toString ();
+
+    getCaptureFormat (sampleRate, channelCount);
+
+    if (autoNameRecordings->isChecked ())
+        outputFileName = defaultDir + "/" + QDateTime::currentDateTime ().toString ().replace (":", ".");
+
+    else
+        outputFileName = QFileDialog::getSaveFileName (this, tr("Choose output file"), defaultDir, tr("Audio files (*.") + codec + ")", nullptr, QFileDialog::DontConfirmOverwrite | QFileDialog::DontUseNativeDialog);
+
+
+    if (outputFileName.isEmpty ())
+        return false;
+
+    if (!outputFileName.contains (QRegExp ("\\." + codec + "$", Qt::CaseInsensitive)))
+        outputFileName += "." + codec;
+
+
+    if (QFile::exists (outputFileName))
+    {
+        if (QMessageBox::question (this, tr("Wait a second !"), tr("This file already exists,\nDo you want to replace it ?")) == QMessageBox::No)
+        {
+            mainWindow->setWindowIcon (QIcon ("Window Icon.png"));
+            return false;
+        }
+        else
+            recordingsTab->removeCurrentFromList ();
+    }
+
+    return true;
+}
+
+void RecorderWidget::start ()
+{
+    if (session->paused ())
+    {
+        session->resume ();
+        timer->start (100);
+        levelsTimer->start (30);
+
+        bStart->setText (tr("Start &recording"));
+        mainWindow->setWindowIcon (QIcon ("Recording.png"));
+
+        bStart->setEnabled (false);
+        bPause->setEnabled (true);
+    }
+    else
+    {
+        unsigned int sampleRate;
+        unsigned short int channelCount;
+
+        session->markStart ();  // The pre-roll goes back from now, not from the end of the file dialog
+
+        if (getFileInfos (sampleRate, channelCount))
+        {
+            session->setBufferDuration (bufferDurationSelecter->value ());
+            session->setLatency (latencySelecter->currentData ().toUInt ());
+            session->setDevices (selectedDevices ());
+            session->setPreRoll (preRollSelecter->value () * 1000);
+            session->setSilenceGate (silenceThresholdSelecter->value () != silenceThresholdSelecter->minimum (), silenceThresholdSelecter->value (), silenceHangoverSelecter->value ());
+            session->setSegmentLimits (segmentDurationSelecter->value () * 60, (unsigned long long int) segmentSizeSelecter->value () * 1024 * 1024);
+            session->setOverloadProtection (AudioRecorder::OverloadProtection (overloadProtectionSelecter->currentIndex ()));
+            session->setMemoryBudget (memoryBudgetSelecter->value ());
+            session->setCaptureRate (advancedOptionsBox->isChecked () ? captureRateSelecter->currentData ().toUInt () : 0);
+            session->setOutputMode (RecordingSession::OutputMode (multiDeviceModeSelecter->currentIndex ()));
+
+            if (!session->start (std::string (outputFileName.toLocal8Bit ()), sampleRate, channelCount))
+            {
+                removeRecordings ();
+                mainWindow->setWindowIcon (QIcon ("Window Icon.png"));
+
+                QMessageBox::critical (this, tr("Error"), tr("Impossible to start recording,\ncheck your microphones and the output folder."));
+                updateMonitoring ();
+
+                return;
+            }
+
+            timer->start (100);
+            levelsTimer->start (30);
+
+
+            mainWindow->setWindowIcon (QIcon ("Recording.png"));
+
+            bStart->setEnabled (false);
+            bPause->setEnabled (true);
+            bStop->setEnabled (true);
+            bAbort->setEnabled (true);
+
+            optionsBox->setEnabled (false);
+        }
+    }
+}
+
+
+void RecorderWidget::pause ()
+{
+    session->pause ();
+    timer->stop ();
+    levelsTimer->stop ();
+    updateLevels ();
+
+
+    bStart->setText (tr("&Resume recording"));
+    mainWindow->setWindowIcon (QIcon ("Paused.png"));
+
+    bStart->setEnabled (true);
+    bPause->setEnabled (false);
+}
+
+
+void RecorderWidget::stop ()
+{
+    bool wasPaused = session->paused ();
+
+    session->pause ();
+    mainWindow->setWindowIcon (QIcon ("Paused.png"));
+
+
+    if (QMessageBox::question (this, tr("Confirmation"), tr("Do you really want to stop recording ?")) == QMessageBox::Yes)
+    {
+        timer->stop ();
+        levelsTimer->stop ();
+        session->stop ();
+        updateLevels ();
+        addRecordings ();
+
+        checkOverruns ();
+        updateMonitoring ();
+
+
+        bStart->setText (tr("Start &recording"));
+        mainWindow->setWindowIcon (QIcon ("Window Icon.png"));
+
+        optionsBox->setEnabled (true);
+
+        bStart->setEnabled (true);
+        bPause->setEnabled (false);
+        bStop->setEnabled (false);
+        bAbort->setEnabled (false);
+    }
+    else
+    {
+        if (wasPaused)
+            mainWindow->setWindowIcon (QIcon ("Paused.png"));
+
+        else
+        {
+            session->resume ();
+            mainWindow->setWindowIcon (QIcon ("Recording.png"));
+        }
+    }
+}
+
+
+void RecorderWidget::abort ()
+{
+    bool wasPaused = session->paused ();
+
+    session->pause ();
+    mainWindow->setWindowIcon (QIcon ("Paused.png"));
+
+
+    if (QMessageBox::question (this, tr("Beware !"), tr("Do you really want to abort recording ?")) == QMessageBox::Yes)
+    {
+        timer->stop ();
+        levelsTimer->stop ();
+        session->stop ();
+        updateLevels ();
+
+        removeRecordings ();
+        updateMonitoring ();
+
+
+        bStart->setText (tr("Start &recording"));
+        mainWindow->setWindowIcon (QIcon ("Window Icon.png"));
+
+        optionsBox->setEnabled (true);
+
+        bStart->setEnabled (true);
+        bPause->setEnabled (false);
+        bStop->setEnabled (false);
+        bAbort->setEnabled (false);
+    }
+    else
+    {
+        if (wasPaused)
+            mainWindow->setWindowIcon (QIcon ("Paused.png"));
+
+        else
+        {
+            session->resume ();
+            mainWindow->setWindowIcon (QIcon ("Recording.png"));
+        }
+    }
+}
+
+
+// If the user closed the app during recording, prompt him/her to save or abort
+
+bool RecorderWidget::beforeExit ()
+{
+    if (session->recording ())
+    {
+        bool wasPaused = session->paused ();
+
+        session->pause ();
+        mainWindow->setWindowIcon (QIcon ("Paused.png"));
+
+
+        QMessageBox::StandardButton answer = QMessageBox::question (this, tr("Wait a second !"), tr("It seems you are still recording,\nDo you want to save before close ?"), QMessageBox::Yes | QMessageBox::No | QMessageBox::Cancel);
+
+        if (answer == QMessageBox::Yes)
+        {
+            session->stop ();
+            addRecordings ();
+
+            return true;
+        }
+        else if (answer == QMessageBox::No)
+        {
+            session->stop ();
+
+            removeRecordings ();
+
+            return true;
+        }
+        else
+        {
+            if (wasPaused)
+                mainWindow->setWindowIcon (QIcon ("Paused.png"));
+
+            else
+            {
+                session->resume ();
+                mainWindow->setWindowIcon (QIcon ("Recording.png"));
+            }
+
+            return false;
+        }
+    }
+
+    return true;
+}
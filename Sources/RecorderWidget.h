@@ -1,118 +1,175 @@
-#ifndef RECORDERWIDGET_H
-#define RECORDERWIDGET_H
-
-
-#include <QTimer>
-
-#include <QPushButton>
-#include <QComboBox>
-#include <QLabel>
-#include <QCheckBox>
-#include "CustomWidgets/DevicesComboBox.h"
-#include "CustomWidgets/AudioLevelWidget.h"
-#include "CustomWidgets/SpectrumWidget.h"
-#include "CustomWidgets/DirectJumpSlider.h"
-#include "RecordingsManagerWidget.h"
-
-#include <QGroupBox>
-#include <QGridLayout>
-
-#include "Tools/AudioRecorder.h"
-
-
-class RecorderWidget : public QWidget
-{
-    Q_OBJECT
-
-    public:
-        RecorderWidget (QTabWidget*, RecordingsManagerWidget*);
-        ~RecorderWidget ();
-
-        bool beforeExit ();  // Prompt user to save before exit
-
-
-    private slots:
-        void start ();
-        void stop ();
-        void pause ();
-        void abort ();
-
-        void changeDefaultDir ();
-
-        void setVolume (int);
-
-        void resetCaptureSettings ();
-
-        void updateTimerLabel ();
-
-
-    private:
-      void loadOptions ();
-
-      void initOptionsBox ();
-      void initFilesOptionsBox ();
-      void initAdvancedOptionsBox ();
-      void initControlsBox ();
-
-      bool getFileInfos (unsigned int&, unsigned short int&);
-
-
-      RecordingsManagerWidget* recordingsTab;
-      QTabWidget* mainWindow;
-
-      AudioRecorder* recorder;
-      QTimer* timer;
-      QLabel* timerLabel;
-
-      QString outputFileName;
-      QString defaultDir;
-
-      QGridLayout* layout;
-
-
-      QGroupBox* optionsBox;
-      QGridLayout* optionsBoxLayout;
-
-        QLabel* chooseDeviceLabel;
-        QComboBox* deviceSelecter;
-
-        QLabel* chooseVolumeLabel;
-        DirectJumpSlider* volumeSelecter;
-        QLabel* overamplificationWarning;
-
-        QLabel* recorderImage;
-
-        QGroupBox* advancedOptionsBox;
-        QGridLayout* advancedOptionsBoxLayout;
-
-          QLabel* chooseCodecLabel;
-          QComboBox* codecSelecter;
-
-          QLabel* chooseRateLabel;
-          QComboBox* rateSelecter;
-
-          QLabel* chooseChannelCountLabel;
-          QComboBox* channelCountSelecter;
-
-        QPushButton* bResetCaptureSettings;
-
-      AudioLevelWidget* levelWidget;
-
-      QWidget* filesOptionsWidget;
-      QGridLayout* filesOptionsWidgetLayout;
-        QLabel* defaultDirLabel;
-        QPushButton* bChooseDefaultDir;
-        QCheckBox* autoNameRecordings;
-
-      QWidget* controlsWidget;
-      QHBoxLayout* controlsLayout;
-        QPushButton* bStart;
-        QPushButton* bStop;
-        QPushButton* bPause;
-        QPushButton* bAbort;
-
-      SpectrumWidget* spectrum;
-};
-
-
-#endif // RECORDERWIDGET_H
+#ifndef RECORDERWIDGET_H
+#define RECORDERWIDGET_H
+
+
+#include <QTimer>
+
+#include <QPushButton>
+#include <QComboBox>
+#include <QLabel>
+#include <QCheckBox>
+#include <QSpinBox>
+#include <QMenu>
+#include "CustomWidgets/DevicesComboBox.h"
+#include "CustomWidgets/AudioLevelWidget.h"
+#include "CustomWidgets/SpectrumWidget.h"
+#include "CustomWidgets/SpectrumAnalyzerWidget.h"
+#include "CustomWidgets/DirectJumpSlider.h"
+#include "RecordingsManagerWidget.h"
+
+#include <QGroupBox>
+#include <QGridLayout>
+
+#include "Tools/RecordingSession.h"
+
+
+class RecorderWidget : public QWidget
+{
+    Q_OBJECT
+
+    public:
+        RecorderWidget (QTabWidget*, RecordingsManagerWidget*);
+        ~RecorderWidget ();
+
+        bool beforeExit ();  // Prompt user to save before exit
+
+
+    private slots:
+        void start ();
+        void stop ();
+        void pause ();
+        void abort ();
+
+        void changeDefaultDir ();
+
+        void setVolume (int);
+
+        void updateExtraDevicesMenu ();
+        void toggleExtraDevice (QAction*);
+        void updateMonitoring ();
+
+        void resetCaptureSettings ();
+
+        void updateTimerLabel ();
+        void updateLevels ();
+
+
+    private:
+      void loadOptions ();
+
+      void initOptionsBox ();
+      void initFilesOptionsBox ();
+      void initAdvancedOptionsBox ();
+      void initControlsBox ();
+
+      void getCaptureFormat (unsigned int&, unsigned short int&);
+      bool getFileInfos (unsigned int&, unsigned short int&);
+      void checkOverruns ();
+
+      std::vector<std::string> selectedDevices ();
+      void addRecordings ();
+      void removeRecordings ();
+
+
+      RecordingsManagerWidget* recordingsTab;
+      QTabWidget* mainWindow;
+
+      RecordingSession* session;
+      QTimer* timer;
+      QTimer* levelsTimer;
+      unsigned int levelsVersion;
+      unsigned int spectrumVersion;
+      std::vector<float> spectrumColumns;
+      QLabel* timerLabel;
+      QLabel* captureStatsLabel;
+      QLabel* timingsLabel;
+
+      QString outputFileName;
+      QString defaultDir;
+
+      QGridLayout* layout;
+
+
+      QGroupBox* optionsBox;
+      QGridLayout* optionsBoxLayout;
+
+        QLabel* chooseDeviceLabel;
+        QComboBox* deviceSelecter;
+        QPushButton* bExtraDevices;
+        QMenu* extraDevicesMenu;
+        QStringList extraDevices;
+
+        QLabel* chooseVolumeLabel;
+        DirectJumpSlider* volumeSelecter;
+        QLabel* overamplificationWarning;
+
+        QLabel* recorderImage;
+
+        QGroupBox* advancedOptionsBox;
+        QGridLayout* advancedOptionsBoxLayout;
+
+          QLabel* chooseCodecLabel;
+          QComboBox* codecSelecter;
+
+          QLabel* chooseRateLabel;
+          QComboBox* rateSelecter;
+
+          QLabel* chooseChannelCountLabel;
+          QComboBox* channelCountSelecter;
+
+          QLabel* chooseLatencyLabel;
+          QComboBox* latencySelecter;
+
+          QLabel* chooseBufferDurationLabel;
+          QSpinBox* bufferDurationSelecter;
+
+          QLabel* chooseMultiDeviceModeLabel;
+          QComboBox* multiDeviceModeSelecter;
+
+          QLabel* choosePreRollLabel;
+          QSpinBox* preRollSelecter;
+
+          QLabel* chooseSilenceThresholdLabel;
+          QSpinBox* silenceThresholdSelecter;
+
+          QLabel* chooseSilenceHangoverLabel;
+          QSpinBox* silenceHangoverSelecter;
+
+          QLabel* chooseSegmentDurationLabel;
+          QSpinBox* segmentDurationSelecter;
+
+          QLabel* chooseSegmentSizeLabel;
+          QSpinBox* segmentSizeSelecter;
+
+          QLabel* chooseOverloadProtectionLabel;
+          QComboBox* overloadProtectionSelecter;
+
+          QLabel* chooseMemoryBudgetLabel;
+          QSpinBox* memoryBudgetSelecter;
+
+          QLabel* chooseCaptureRateLabel;
+          QComboBox* captureRateSelecter;
+
+        QPushButton* bResetCaptureSettings;
+
+      AudioLevelWidget* levelWidget;
+
+      QWidget* filesOptionsWidget;
+      QGridLayout* filesOptionsWidgetLayout;
+        QLabel* defaultDirLabel;
+        QPushButton* bChooseDefaultDir;
+        QCheckBox* autoNameRecordings;
+
+      QWidget* controlsWidget;
+      QHBoxLayout* controlsLayout;
+        QPushButton* bStart;
+        QPushButton* bStop;
+        QPushButton* bPause;
+        QPushButton* bAbort;
+
+      SpectrumWidget* spectrum;
+      SpectrumAnalyzerWidget* analyzer;
+};
+
+
+#endif // RECORDERWIDGET_H
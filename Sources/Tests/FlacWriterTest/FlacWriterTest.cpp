@@ -0,0 +1,146 @@
+#include <QtTest>
+#include <QTemporaryDir>
+#include <QDir>
+
+#include <FLAC/stream_decoder.h>
+
+#include <vector>
+#include <random>
+
+#include "FlacWriter.h"
+
+
+static const unsigned int sampleRate = 44100;
+static const unsigned int channelCount = 2;
+
+
+class FlacWriterTest : public QObject
+{
+    Q_OBJECT
+
+    private slots:
+        void initTestCase ();
+
+        void decodedByLibFlac_data ();
+        void decodedByLibFlac ();
+
+
+    private:
+        QTemporaryDir folder;
+};
+
+
+////////////////////////////////////////  Reference decoder
+
+
+struct Decoding
+{
+    const std::vector<sf::Int16>* expected;
+    unsigned long long int decodedFrames;
+    unsigned long long int misplacedFrames;  // Frames whose number gives another position than the one reached
+    unsigned long long int wrongSamples;
+    unsigned int errorsCount;
+};
+
+static FLAC__StreamDecoderWriteStatus onFrameDecoded (const FLAC__StreamDecoder*, const FLAC__Frame* frame, const FLAC__int32* const buffer[], void* data)
+{
+    Decoding& decoding = *static_cast<Decoding*> (data);
+
+    if (frame->header.number.sample_number != decoding.decodedFrames)
+        decoding.misplacedFrames++;
+
+    for (unsigned int i = 0 ; i != frame->header.blocksize ; i++)
+        for (unsigned int channel = 0 ; channel != channelCount ; channel++)
+        {
+            std::size_t position = (decoding.decodedFrames + i) * channelCount + channel;
+
+            if (position >= decoding.expected->size () || buffer[channel][i] != decoding.expected->at (position))
+                decoding.wrongSamples++;
+        }
+
+    decoding.decodedFrames += frame->header.blocksize;
+
+    return FLAC__STREAM_DECODER_WRITE_STATUS_CONTINUE;
+}
+
+static void onDecodingError (const FLAC__StreamDecoder*, FLAC__StreamDecoderErrorStatus, void* data)  // Lost sync, bad header or CRC
+{
+    static_cast<Decoding*> (data)->errorsCount++;
+}
+
+
+////////////////////////////////////////  Tests
+
+
+void FlacWriterTest::initTestCase ()
+{
+    QVERIFY (folder.isValid ());
+    QDir::setCurrent (folder.path ());  // The seek index of the written files goes there
+}
+
+
+void FlacWriterTest::decodedByLibFlac_data ()
+{
+    QTest::addColumn<unsigned int> ("threadsCount");
+    QTest::addColumn<unsigned int> ("blockSize");
+    QTest::addColumn<unsigned int> ("blocksCount");
+
+    // Frame numbers take 1 byte below 128, 2 below 2048, 3 below 65536 then 4
+    QTest::newRow ("standard blocks, 2 bytes numbers") << 1U << 4096U << 300U;
+    QTest::newRow ("small blocks, up to 4 bytes numbers") << 1U << 16U << 70000U;
+    QTest::newRow ("small blocks, threads pool") << 4U << 16U << 70000U;
+}
+
+void FlacWriterTest::decodedByLibFlac ()
+{
+    QFETCH (unsigned int, threadsCount);
+    QFETCH (unsigned int, blockSize);
+    QFETCH (unsigned int, blocksCount);
+
+    std::string fileName (QDir (folder.path ()).filePath (QString ("Take %1.flac").arg (QTest::currentDataTag ())).toLocal8Bit ());
+
+
+    std::vector<sf::Int16> samples ((blocksCount * blockSize + blockSize / 3) * channelCount);  // The last block is a short one
+    std::minstd_rand generator (blocksCount);
+
+    for (std::size_t i = 0 ; i != samples.size () ; i++)  // A ramp for the predictors, some noise for the residuals
+        samples[i] = sf::Int16 (int ((i / channelCount) * 13 % 40000) - 20000 + int (generator () % 512));
+
+    {
+        FlacWriter writer (threadsCount, blockSize);
+
+        QVERIFY (writer.open (fileName, sampleRate, channelCount));
+
+        for (std::size_t written = 0 ; written != samples.size () ; )  // In chunks not aligned on the blocks
+        {
+            std::size_t count = std::min<std::size_t> (samples.size () - written, 4410 * channelCount);
+
+            writer.write (&samples[written], count);
+            written += count;
+        }
+    }
+
+
+    Decoding decoding = {&samples, 0, 0, 0, 0};
+    FLAC__StreamDecoder* decoder = FLAC__stream_decoder_new ();
+
+    QVERIFY (decoder != nullptr);
+    QCOMPARE (FLAC__stream_decoder_init_file (decoder, fileName.c_str (), onFrameDecoded, nullptr, onDecodingError, &decoding), FLAC__STREAM_DECODER_INIT_STATUS_OK);
+
+    bool decoded = FLAC__stream_decoder_process_until_end_of_stream (decoder);
+
+    FLAC__stream_decoder_finish (decoder);
+    FLAC__stream_decoder_delete (decoder);
+
+
+    QVERIFY (decoded);
+    QCOMPARE (decoding.errorsCount, 0U);
+    QCOMPARE (decoding.misplacedFrames, 0ULL);
+    QCOMPARE (decoding.wrongSamples, 0ULL);
+    QCOMPARE (decoding.decodedFrames, (unsigned long long int) (samples.size () / channelCount));
+}
+
+
+QTEST_MAIN (FlacWriterTest)
+
+#include "FlacWriterTest.moc"
@@ -0,0 +1,8 @@
+include (../Tests.pri)
+
+
+SOURCES += \
+        FlacWriterTest.cpp \
+        ../../Tools/FlacWriter.cpp \
+        ../../Tools/SeekIndex.cpp \
+        ../../Tools/CacheFiles.cpp
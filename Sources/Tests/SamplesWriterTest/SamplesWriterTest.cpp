@@ -0,0 +1,116 @@
+#include <QtTest>
+#include <QTemporaryDir>
+#include <QDir>
+
+#include <SFML/Audio.hpp>
+
+#include <vector>
+
+#include "SamplesWriter.h"
+
+
+static const unsigned int sampleRate = 44100;
+
+
+class SamplesWriterTest : public QObject
+{
+    Q_OBJECT
+
+    private slots:
+        void initTestCase ();
+
+        void unopenableSegmentKeepsWriting ();
+        void unresampledRateKeptInHeader ();
+
+
+    private:
+        QTemporaryDir folder;
+};
+
+
+void SamplesWriterTest::initTestCase ()
+{
+    QVERIFY (folder.isValid ());
+    QDir::setCurrent (folder.path ());  // The cache of the written files goes there too
+}
+
+
+void SamplesWriterTest::unopenableSegmentKeepsWriting ()  // A full disk or a read-only folder must not stop the encoder thread
+{
+    std::string fileName (QDir (folder.path ()).filePath ("Take.wav").toLocal8Bit ());
+
+    QVERIFY (QDir (folder.path ()).mkdir ("Take (part 2).wav"));  // The second segment cannot be created over a folder
+
+
+    SamplesWriter writer;
+
+    QVERIFY (writer.open (fileName, sampleRate, 1));
+    writer.setSegmentLimits (1, 0);
+    writer.setBufferDuration (10000);  // Everything fits in the ring, no need to wait for the encoder
+    writer.begin ();
+
+    std::vector<sf::Int16> chunk (sampleRate / 10);
+    unsigned long long int writtenFrames = 0;
+
+    while (writtenFrames != 3 * sampleRate)
+    {
+        for (std::size_t i = 0 ; i != chunk.size () ; i++)
+            chunk[i] = sf::Int16 ((writtenFrames + i) % 20000);
+
+        QVERIFY (writer.write (&chunk[0], chunk.size ()));
+        writtenFrames += chunk.size ();
+    }
+
+    writer.finish ();  // Used to loop forever once the first segment was full
+
+
+    QCOMPARE (writer.files ().size (), std::size_t (1));
+
+    sf::InputSoundFile file;
+    QVERIFY (file.openFromFile (fileName));
+    QCOMPARE (file.getSampleCount (), sf::Uint64 (writtenFrames));
+
+    std::vector<sf::Int16> samples (writtenFrames);
+    QCOMPARE (file.read (&samples[0], samples.size ()), sf::Uint64 (writtenFrames));
+
+    for (std::size_t i = 0 ; i != samples.size () ; i++)
+        QCOMPARE (samples[i], sf::Int16 (i % 20000));
+}
+
+void SamplesWriterTest::unresampledRateKeptInHeader ()  // A ratio the resampler refuses is written at the capture rate, and says so
+{
+    std::string fileName (QDir (folder.path ()).filePath ("Odd rate.wav").toLocal8Bit ());
+    const unsigned int captureRate = sampleRate + 1;
+
+
+    SamplesWriter writer;
+
+    QVERIFY (writer.open (fileName, sampleRate, 1));
+    writer.setInputRate (captureRate);
+    writer.setBufferDuration (10000);
+    writer.begin ();
+
+    std::vector<sf::Int16> samples (captureRate);
+
+    for (std::size_t i = 0 ; i != samples.size () ; i++)
+        samples[i] = sf::Int16 (i % 20000);
+
+    QVERIFY (writer.write (&samples[0], samples.size ()));
+
+    writer.finish ();
+
+
+    sf::InputSoundFile file;
+    QVERIFY (file.openFromFile (fileName));
+    QCOMPARE (file.getSampleRate (), captureRate);
+    QCOMPARE (file.getSampleCount (), sf::Uint64 (samples.size ()));
+
+    std::vector<sf::Int16> readSamples (samples.size ());
+    QCOMPARE (file.read (&readSamples[0], readSamples.size ()), sf::Uint64 (samples.size ()));
+    QVERIFY (readSamples == samples);
+}
+
+
+QTEST_MAIN (SamplesWriterTest)
+
+#include "SamplesWriterTest.moc"
@@ -0,0 +1,19 @@
+include (../Tests.pri)
+
+
+SOURCES += \
+        SamplesWriterTest.cpp \
+        ../../Tools/SamplesWriter.cpp \
+        ../../Tools/SampleStore.cpp \
+        ../../Tools/Resampler.cpp \
+        ../../Tools/PeakFile.cpp \
+        ../../Tools/CacheFiles.cpp \
+        ../../Tools/SeekIndex.cpp \
+        ../../Tools/FlacWriter.cpp \
+        ../../Tools/OpusWriter.cpp \
+        ../../Tools/WavWriter.cpp \
+        ../../Tools/SoundFileWriters.cpp
+
+
+HEADERS += \
+        ../../Tools/SamplesWriter.h
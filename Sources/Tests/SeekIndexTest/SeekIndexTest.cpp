@@ -0,0 +1,199 @@
+#include <QtTest>
+#include <QTemporaryDir>
+#include <QDir>
+#include <QFile>
+
+#include <SFML/Audio.hpp>
+
+#include <cmath>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "SeekIndex.h"
+#include "CacheFiles.h"
+#include "FlacWriter.h"
+#include "FlacReader.h"
+#include "VorbisReader.h"
+
+
+static const unsigned int sampleRate = 44100;
+static const unsigned int channelCount = 2;
+static const unsigned int durationSeconds = 20;  // More than 128 FLAC frames, their numbers take 2 bytes
+static const std::size_t comparedFrames = 6000;  // More than a FLAC block after each target
+
+
+class SeekIndexTest : public QObject
+{
+    Q_OBJECT
+
+    private slots:
+        void initTestCase ();
+
+        void seekMatchesLinearDecoding_data ();
+        void seekMatchesLinearDecoding ();
+
+
+    private:
+        QTemporaryDir folder;
+};
+
+
+////////////////////////////////////////  Helpers
+
+
+static std::vector<sf::Int16> testSignal ()  // A sweep in opposite directions on both channels, something for the encoders to work on
+{
+    std::vector<sf::Int16> samples (std::size_t (durationSeconds) * sampleRate * channelCount);
+    double phases[channelCount] = {0, 0};
+
+    for (std::size_t frame = 0 ; frame != samples.size () / channelCount ; frame++)
+        for (unsigned int channel = 0 ; channel != channelCount ; channel++)
+        {
+            double progress = double (frame) / (samples.size () / channelCount);
+            double frequency = 100 + 8000 * (channel == 0 ? progress : 1 - progress);
+
+            phases[channel] += 2 * 3.14159265358979323846 * frequency / sampleRate;
+            samples[frame * channelCount + channel] = sf::Int16 (12000 * std::sin (phases[channel]));
+        }
+
+    return samples;
+}
+
+static bool writeRecording (const std::string& fileName, const QString& format, const std::vector<sf::Int16>& samples)
+{
+    if (format == "flac")  // Our writer, which saves its own index when it closes
+    {
+        FlacWriter writer;
+
+        if (!writer.open (fileName, sampleRate, channelCount))
+            return false;
+
+        writer.write (&samples[0], samples.size ());
+        return true;
+    }
+
+    sf::OutputSoundFile writer;  // SFML encodes Ogg Vorbis, without any index
+
+    if (!writer.openFromFile (fileName, sampleRate, channelCount))
+        return false;
+
+    writer.write (&samples[0], samples.size ());
+    return true;
+}
+
+static std::unique_ptr<sf::SoundFileReader> createReader (const QString& format, const SeekIndex* index)
+{
+    if (format == "flac")
+        return std::unique_ptr<sf::SoundFileReader> (new FlacReader (index));
+
+    return std::unique_ptr<sf::SoundFileReader> (new VorbisReader (index));
+}
+
+static std::size_t readUpTo (sf::SoundFileReader& reader, sf::Int16* samples, std::size_t samplesCount)  // The readers may stop at the end of a frame or a page
+{
+    std::size_t count = 0;
+
+    while (count != samplesCount)
+    {
+        sf::Uint64 readSamples = reader.read (samples + count, samplesCount - count);
+
+        if (readSamples == 0)
+            break;
+
+        count += readSamples;
+    }
+
+    return count;
+}
+
+
+////////////////////////////////////////  Tests
+
+
+void SeekIndexTest::initTestCase ()
+{
+    QVERIFY (folder.isValid ());
+    QDir::setCurrent (folder.path ());  // The indexes go there
+}
+
+
+void SeekIndexTest::seekMatchesLinearDecoding_data ()
+{
+    QTest::addColumn<QString> ("format");
+    QTest::addColumn<bool> ("scanned");
+
+    QTest::newRow ("FLAC, index of the writer") << QString ("flac") << false;
+    QTest::newRow ("FLAC, scanned frame headers") << QString ("flac") << true;
+    QTest::newRow ("Ogg Vorbis, scanned page headers") << QString ("ogg") << true;
+}
+
+void SeekIndexTest::seekMatchesLinearDecoding ()  // After a jump through the index, the samples must be those of a decoding from the start
+{
+    QFETCH (QString, format);
+    QFETCH (bool, scanned);
+
+    QString recording = QDir (folder.path ()).filePath (QString ("Take %1.%2").arg (QTest::currentDataTag ()).arg (format));
+    std::string fileName (recording.toLocal8Bit ());
+
+    QVERIFY (writeRecording (fileName, format, testSignal ()));
+
+    if (scanned)
+    {
+        std::atomic<bool> stopRequested (false);
+
+        QFile::remove (CacheFiles::path (recording, "seek"));
+        QVERIFY (SeekIndexBuilder ().scan (recording, stopRequested));
+    }
+
+    SeekIndex index;
+    QVERIFY (index.open (recording));
+
+
+    // Reference : the whole file, never seeking
+
+    sf::FileInputStream linearStream;
+    QVERIFY (linearStream.open (fileName));
+
+    std::unique_ptr<sf::SoundFileReader> linearReader = createReader (format, nullptr);
+    sf::SoundFileReader::Info info;
+
+    QVERIFY (linearReader->open (linearStream, info));
+    QCOMPARE (info.channelCount, channelCount);
+
+    std::vector<sf::Int16> reference (info.sampleCount);
+    QCOMPARE (readUpTo (*linearReader, &reference[0], reference.size ()), reference.size ());
+
+
+    // Jumps through the index, forward and backward, on and around the points and the blocks
+
+    sf::FileInputStream indexedStream;
+    QVERIFY (indexedStream.open (fileName));
+
+    std::unique_ptr<sf::SoundFileReader> indexedReader = createReader (format, &index);
+    QVERIFY (indexedReader->open (indexedStream, info));
+
+    unsigned long long int totalFrames = reference.size () / channelCount;
+    std::vector<unsigned long long int> targets ({totalFrames / 2 + 7, 0, 1, 4095, 4096, 4097, sampleRate / 4, sampleRate / 4 + 1,
+                                                  12345, 3 * sampleRate + 999, totalFrames - comparedFrames, totalFrames / 3, 5000});
+
+    std::vector<sf::Int16> samples (comparedFrames * channelCount);
+
+    for (unsigned long long int target : targets)
+    {
+        indexedReader->seek (target * channelCount);
+
+        std::size_t expectedCount = std::min<std::size_t> (samples.size (), reference.size () - target * channelCount);
+
+        QCOMPARE (readUpTo (*indexedReader, &samples[0], expectedCount), expectedCount);
+
+        for (std::size_t i = 0 ; i != expectedCount ; i++)
+            if (samples[i] != reference[target * channelCount + i])
+                QFAIL (qPrintable (QString ("Sample %1 differs after a seek to frame %2").arg (i).arg (target)));
+    }
+}
+
+
+QTEST_MAIN (SeekIndexTest)
+
+#include "SeekIndexTest.moc"
@@ -0,0 +1,10 @@
+include (../Tests.pri)
+
+
+SOURCES += \
+        SeekIndexTest.cpp \
+        ../../Tools/SeekIndex.cpp \
+        ../../Tools/CacheFiles.cpp \
+        ../../Tools/FlacWriter.cpp \
+        ../../Tools/FlacReader.cpp \
+        ../../Tools/VorbisReader.cpp
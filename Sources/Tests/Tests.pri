@@ -0,0 +1,30 @@
+QT += testlib
+QT -= gui
+
+CONFIG += c++17 console testcase
+CONFIG -= app_bundle
+
+
+INCLUDEPATH += $$PWD/../Tools
+
+
+LIBS += -LC:/SFML/lib
+
+#Audio Related Libs
+LIBS += -lsfml-audio          #SFML Dynamic Module
+LIBS += -lopenal32              #Dependency
+LIBS += -lFLAC                  #Dependency
+LIBS += -lvorbisenc             #Dependency
+LIBS += -lvorbisfile            #Dependency
+LIBS += -lvorbis                #Dependency
+LIBS += -logg                   #Dependency
+LIBS += -lopus                  #OpusWriter, pages through libogg
+
+#SFML-System Libs
+LIBS += -lsfml-system         #SFML Dynamic Module
+LIBS += -lwinmm                 #Dependency
+
+DEFINES += FLAC__NO_DLL          #FlacReader, libFLAC is linked statically
+
+INCLUDEPATH += C:/SFML/include
+DEPENDPATH += C:/SFML/include
@@ -0,0 +1,46 @@
+#ifndef AUDIOLEVELS_H
+#define AUDIOLEVELS_H
+
+
+#include <algorithm>
+
+
+// Meter values of one captured chunk, peak and RMS are normalized to full scale
+// The meter values are in dBFS, after the ballistics of MeterBallistics
+
+struct ChannelLevels
+{
+    float peak;
+    float rms;
+    unsigned int clippedSamples;
+
+    float meterPeak;
+    float meterRms;
+    float heldPeak;
+};
+
+struct AudioLevels
+{
+    static const unsigned short int maxChannels = 8;
+
+    unsigned short int channelCount;
+    ChannelLevels channels[maxChannels];
+
+    float gainReduction;  // In dB, applied by the limiter, 0 when clipping is used instead
+
+
+    AudioLevels () : channelCount (0), channels (), gainReduction (0) { }
+
+    float level () const  // Loudest channel, used by the mixed down displays
+    {
+        float loudest = 0;
+
+        for (unsigned short int i = 0 ; i != channelCount ; i++)
+            loudest = std::max (loudest, channels[i].rms);
+
+        return loudest;
+    }
+};
+
+
+#endif // AUDIOLEVELS_H
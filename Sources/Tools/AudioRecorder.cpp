@@ -1,140 +1,579 @@
-#include "AudioRecorder.h"
-
-
-////////////////////////////////////////  Constructor / Destructor
-
-
-AudioRecorder::AudioRecorder () : QObject (), sf::SoundRecorder ()
-{
-    _recording = false;
-    _paused = false;
-    _volume = 1;
-
-    setProcessingInterval (sf::milliseconds (10));
-}
-
-AudioRecorder::~AudioRecorder ()  // Stop and clean recorder before removal
-{
-    stop ();
-}
-
-
-////////////////////////////////////////  Controls
-
-
-void AudioRecorder::pause ()
-{
-    _paused = true;
-    emit audioLevel (0);
-}
-
-void AudioRecorder::resume ()
-{
-    _paused = false;
-}
-
-
-bool AudioRecorder::onStart ()  // Called if the user want to start recording
-{
-    _samplesCount = 0;
-    _paused = false;
-    _recording = true;
-
-    emit started ();
-    return true;
-}
-
-void AudioRecorder::onStop ()  // Called if the user want to stop recording
-{
-    _recording = false;
-    _paused = false;
-
-    emit audioLevel (0);
-    outputStream.openFromFile ("", 0, 0);
-}
-
-
-////////////////////////////////////////  Others
-
-
-bool AudioRecorder::setOutputStream (std::string fileName, unsigned int sampleRate, unsigned int channelCount)
-{
-    return outputStream.openFromFile (fileName, sampleRate, channelCount);
-}
-
-void AudioRecorder::setVolume (unsigned short int volume)
-{
-    _volume = volume;
-}
-
-
-bool AudioRecorder::paused ()
-{
-    return _paused;
-}
-
-bool AudioRecorder::recording ()
-{
-    return _recording;
-}
-
-unsigned int AudioRecorder::durationAsMilliseconds ()
-{
-    return _samplesCount / getSampleRate () / getChannelCount ();
-}
-
-
-bool AudioRecorder::onProcessSamples (const sf::Int16* samples, std::size_t samplesCount)
-{
-    if (!_paused)
-    {
-        if (_volume != 100)
-        {
-            float volumeCoefficient = float (_volume) / 100.0;
-
-            short int amplifiedSamples[samplesCount];
-            int amplifiedSample;
-
-            for (unsigned long long int i = 0 ; i != samplesCount ; i++)
-            {
-                amplifiedSample = samples[i] * volumeCoefficient;
-
-                if (amplifiedSample > 32767)
-                    amplifiedSamples[i] = 32767;
-
-                else if (amplifiedSample < -32768)
-                    amplifiedSamples[i] = -32768;
-
-                else
-                    amplifiedSamples[i] = amplifiedSample;
-            }
-
-            outputStream.write (amplifiedSamples, samplesCount);
-
-            emit audioLevel (computeLevel (amplifiedSamples, samplesCount));
-        }
-        else
-        {
-            outputStream.write (samples, samplesCount);
-
-            emit audioLevel (computeLevel (samples, samplesCount));
-        }
-
-        _samplesCount += samplesCount;
-    }
-
-    return true;
-}
-
-
-double AudioRecorder::computeLevel (const short int samples[], std::size_t samplesCount)
-{
-    unsigned long long int level = 0;
-
-    for (unsigned int i = 0 ; i != samplesCount ; i++)
-        level += abs (samples[i]);
-
-
-    return level / samplesCount / 32767.0;
-}
-
+#include <cmath>
+#include <fstream>
+
+#include <QDateTime>
+
+#include "AudioRecorder.h"
+#include "GainKernel.h"
+
+
+static const unsigned int gateLookBackDuration = 250;  // Milliseconds kept while the gate is closed, written back when it opens not to cut word beginnings
+static const std::size_t maxSkippedRanges = 4096;
+
+
+////////////////////////////////////////  Constructor / Destructor
+
+
+AudioRecorder::AudioRecorder () : QObject (), sf::SoundRecorder ()
+{
+    _recording = false;
+    _paused = false;
+    _monitoring = false;
+    _volume = 1;
+    _overloadProtection = Clipping;
+
+    recordRequested = false;
+    writing = false;
+    _preRoll = 0;
+
+    _silenceGate = false;
+    gating = false;
+    gateOpen = true;
+    capturedFrames = 0;
+    gateClosedAt = 0;
+
+    writer = &ownWriter;
+    writerInput = 0;
+
+    alignmentPending = false;
+    framesToSkip = 0;
+
+    _spectrumAnalysis = false;
+    analyzing = false;
+
+    setLatency (20);
+
+    connect (&ownWriter, SIGNAL (segmentCompleted (QString)), this, SIGNAL (segmentCompleted (QString)));
+}
+
+AudioRecorder::~AudioRecorder ()  // Stop and clean recorder before removal
+{
+    stop ();
+}
+
+
+////////////////////////////////////////  Controls
+
+
+void AudioRecorder::pause ()
+{
+    _paused = true;
+}
+
+void AudioRecorder::resume ()
+{
+    _paused = false;
+}
+
+
+bool AudioRecorder::monitor (unsigned int sampleRate)  // Capture without writing anything, only the pre-roll is kept
+{
+    _monitoring = true;
+
+    if (!start (sampleRate))
+    {
+        _monitoring = false;
+        return false;
+    }
+
+    return true;
+}
+
+void AudioRecorder::record ()  // Switch from monitoring to recording, the pre-roll is written first
+{
+    beginRecording ();
+
+    recordRequested = true;
+}
+
+
+bool AudioRecorder::onStart ()  // Called if the user want to start recording or monitoring
+{
+    _paused = false;
+
+    amplifiedSamples.resize (getSampleRate () * getChannelCount ());  // One second, far above the processing interval
+
+    limiter.setAutomaticGain (_overloadProtection == AutomaticGain);
+    limiter.prepare (getSampleRate (), getChannelCount ());
+    ballistics.reset ();
+    levelsSnapshot.store (AudioLevels ());
+
+    analyzing = _spectrumAnalysis;
+
+    if (analyzing)
+        analyzer.start (getSampleRate (), getChannelCount ());
+
+    silence.assign (getSampleRate () / 10 * getChannelCount (), 0);  // A monitored recorder may be aligned later
+
+    preRollBuffer.allocate (_monitoring ? std::size_t (getSampleRate ()) * _preRoll / 1000 * getChannelCount () : 0);
+    gateLookBack.allocate (std::size_t (getSampleRate ()) * (_latency + gateLookBackDuration) / 1000 * getChannelCount ());
+    skippedRanges.reserve (maxSkippedRanges);
+
+    callbacksCount = 0;
+    processingNanoseconds = 0;
+    _timings.reset (getSampleRate ());
+    startTime = std::chrono::steady_clock::now ();
+
+    recordRequested = false;
+    writing = !_monitoring;
+
+    if (!_monitoring)
+        beginRecording ();
+
+    return true;
+}
+
+void AudioRecorder::beginRecording ()
+{
+    _samplesCount = 0;
+    _recording = true;
+
+    gating = _silenceGate && writer == &ownWriter;  // Skipping chunks of one input would desynchronize a shared file
+    gateOpen = true;
+    silenceGate.reset ();
+    gateLookBack.clear ();
+    capturedFrames = 0;
+    skippedRanges.clear ();
+
+    if (writer == &ownWriter)  // A shared writer is started by its owner
+    {
+        ownWriter.setBufferDuration (std::max (ownWriter.bufferDuration (), 4 * _latency + _preRoll));  // The ring must hold several chunks and the pre-roll
+        ownWriter.setInputRate (getSampleRate ());  // Resampled by the writer if the file has another rate
+        ownWriter.begin ();
+    }
+
+    emit started ();
+}
+
+void AudioRecorder::onStop ()  // Called if the user want to stop recording
+{
+    if (writing && _overloadProtection != Clipping)  // The last look-ahead of audio is still in the limiter
+    {
+        std::size_t samplesCount = limiter.flush (&amplifiedSamples[0]);
+
+        if (!gating || gateOpen)
+        {
+            writer->write (&amplifiedSamples[0], samplesCount, writerInput);
+            _samplesCount += samplesCount;
+        }
+    }
+
+    if (_recording)
+        writeTimings ();
+
+    _recording = false;
+    _paused = false;
+    _monitoring = false;
+
+    recordRequested = false;
+    writing = false;
+    preRollBuffer.clear ();
+
+    if (gating)
+        writeSkippedRanges ();
+
+    gating = false;
+
+    alignmentPending = false;
+    framesToSkip = 0;
+
+    levelsSnapshot.store (AudioLevels ());
+
+    analyzer.stop ();
+    analyzing = false;
+
+    if (writer == &ownWriter)
+        ownWriter.finish ();
+}
+
+
+////////////////////////////////////////  Others
+
+
+bool AudioRecorder::setOutputStream (std::string fileName, unsigned int sampleRate, unsigned int channelCount)
+{
+    outputFileName = fileName;
+
+    return ownWriter.open (fileName, sampleRate, channelCount);
+}
+
+void AudioRecorder::setBufferDuration (unsigned int milliseconds)
+{
+    ownWriter.setBufferDuration (milliseconds);
+}
+
+void AudioRecorder::setSegmentLimits (unsigned int seconds, unsigned long long int bytes)
+{
+    ownWriter.setSegmentLimits (seconds, bytes);
+}
+
+void AudioRecorder::setMemoryBudget (unsigned int megabytes)
+{
+    ownWriter.setMemoryBudget (megabytes);
+}
+
+void AudioRecorder::setSpectrumAnalysis (bool enabled)  // Applied at next start or monitoring
+{
+    _spectrumAnalysis = enabled;
+}
+
+void AudioRecorder::shareWriter (SamplesWriter* sharedWriter, unsigned short int input)  // Send samples to one input of another writer, nullptr to get back to the own one
+{
+    writer = sharedWriter ? sharedWriter : &ownWriter;
+    writerInput = sharedWriter ? input : 0;
+}
+
+void AudioRecorder::alignTo (std::chrono::steady_clock::time_point startTime)  // Samples captured before this time are dropped, silence is added if capture starts later
+{
+    alignment = startTime;
+    alignmentPending = true;
+}
+
+void AudioRecorder::setLatency (unsigned int milliseconds)  // Time between two capture callbacks, must be set before start
+{
+    _latency = milliseconds;
+
+    setProcessingInterval (sf::milliseconds (milliseconds));
+}
+
+void AudioRecorder::setSilenceGate (bool enabled, float threshold, unsigned int hangover)  // Threshold in dBFS, hangover in milliseconds, applied at next recording start
+{
+    _silenceGate = enabled;
+
+    silenceGate.setThresholds (threshold, threshold - 6);
+    silenceGate.setHangover (hangover);
+}
+
+void AudioRecorder::setPreRoll (unsigned int milliseconds)  // Audio kept while monitoring, applied at next monitoring start
+{
+    _preRoll = milliseconds;
+}
+
+void AudioRecorder::setVolume (unsigned short int volume)
+{
+    _volume = volume;
+}
+
+void AudioRecorder::setOverloadProtection (OverloadProtection protection)  // Applied at next start
+{
+    _overloadProtection = protection;
+}
+
+
+bool AudioRecorder::paused ()
+{
+    return _paused;
+}
+
+bool AudioRecorder::recording ()
+{
+    return _recording;
+}
+
+bool AudioRecorder::monitoring ()
+{
+    return _monitoring && !_recording;
+}
+
+std::size_t AudioRecorder::bufferHighWaterMark ()
+{
+    return writer->highWaterMark ();
+}
+
+unsigned int AudioRecorder::bufferOverruns ()
+{
+    return writer->overruns ();
+}
+
+unsigned long long int AudioRecorder::memoryUsed ()  // Audio waiting in memory for a slow disk
+{
+    return writer->memoryUsed ();
+}
+
+unsigned long long int AudioRecorder::memoryPeak ()  // What the memory budget has to cover for this disk
+{
+    return writer->memoryPeak ();
+}
+
+unsigned long long int AudioRecorder::droppedFrames ()  // Lost when the memory budget was exhausted
+{
+    return writer->droppedFrames ();
+}
+
+unsigned int AudioRecorder::dropEvents ()
+{
+    return writer->dropEvents ();
+}
+
+
+double AudioRecorder::callbacksPerSecond ()
+{
+    double elapsedTime = std::chrono::duration<double> (std::chrono::steady_clock::now () - startTime).count ();
+
+    return elapsedTime > 0 ? callbacksCount / elapsedTime : 0;
+}
+
+double AudioRecorder::processingLoad ()  // Part of the time spent in the capture callback
+{
+    double elapsedTime = std::chrono::duration<double, std::nano> (std::chrono::steady_clock::now () - startTime).count ();
+
+    return elapsedTime > 0 ? processingNanoseconds / elapsedTime : 0;
+}
+
+
+const CaptureTimings& AudioRecorder::timings ()  // Safe to read from any thread while capturing
+{
+    return _timings;
+}
+
+
+AudioLevels AudioRecorder::levels (unsigned int* version)  // Levels of the last captured chunk, safe to call from any thread
+{
+    return levelsSnapshot.load (version);
+}
+
+
+SpectrumBands AudioRecorder::spectrum (unsigned int* version)  // Bands of the last analyzed window, safe to call from any thread
+{
+    return analyzer.bands (version);
+}
+
+std::size_t AudioRecorder::spectrumColumns (float* magnitudes, std::size_t capacity, unsigned short int& bandCount)  // Every analyzed window since the last call, from the thread controlling the recorder
+{
+    return analyzer.popColumns (magnitudes, capacity, bandCount);
+}
+
+
+const std::vector<std::string>& AudioRecorder::outputFiles ()  // Every segment of the last recording
+{
+    return writer->files ();
+}
+
+
+unsigned int AudioRecorder::durationAsMilliseconds ()
+{
+    return _samplesCount / getSampleRate () / getChannelCount ();
+}
+
+
+bool AudioRecorder::onProcessSamples (const sf::Int16* samples, std::size_t samplesCount)
+{
+    std::chrono::steady_clock::time_point callbackStart = std::chrono::steady_clock::now ();
+
+    _timings.callbackStarted (callbackStart, samplesCount / getChannelCount ());
+
+    if (recordRequested.exchange (false))
+    {
+        if (alignmentPending)
+            alignPreRoll (samplesCount, callbackStart);
+
+        flush (preRollBuffer);
+        writing = true;
+    }
+
+    if (!_paused && align (samples, samplesCount, callbackStart))
+    {
+        AudioLevels levels;
+        const sf::Int16* processedSamples = samples;
+
+        if (samplesCount > amplifiedSamples.size ())  // Only happens if SFML delivers a bigger chunk than expected
+            amplifiedSamples.resize (samplesCount);
+
+        if (_overloadProtection != Clipping)
+        {
+            limiter.process (samples, &amplifiedSamples[0], samplesCount, float (_volume) / 100.0);
+
+            GainKernel::process (&amplifiedSamples[0], nullptr, samplesCount, 1, getChannelCount (), levels);
+            levels.gainReduction = limiter.gainReduction ();
+
+            limiter.updateAutomaticGain (levels.level (), double (samplesCount) / getChannelCount () / getSampleRate ());
+
+            processedSamples = &amplifiedSamples[0];
+        }
+        else if (_volume != 100)
+        {
+            GainKernel::process (samples, &amplifiedSamples[0], samplesCount, float (_volume) / 100.0, getChannelCount (), levels);
+
+            processedSamples = &amplifiedSamples[0];
+        }
+        else
+            GainKernel::process (samples, nullptr, samplesCount, 1, getChannelCount (), levels);
+
+        ballistics.process (levels, double (samplesCount) / getChannelCount () / getSampleRate ());
+        levelsSnapshot.store (levels);
+
+        if (analyzing)
+            analyzer.push (processedSamples, samplesCount);
+
+
+        if (writing)
+        {
+            // Not through _paused : the gate needs the levels computed above to reopen, and must not undo a pause of the user
+            if (!gating || passGate (processedSamples, samplesCount, levels))
+            {
+                writer->write (processedSamples, samplesCount, writerInput);
+
+                _samplesCount += samplesCount;
+            }
+
+            capturedFrames += samplesCount / getChannelCount ();
+        }
+        else
+            preRollBuffer.store (processedSamples, samplesCount);
+    }
+
+    std::chrono::steady_clock::time_point callbackEnd = std::chrono::steady_clock::now ();
+
+    callbacksCount++;
+    processingNanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds> (callbackEnd - callbackStart).count ();
+    _timings.callbackFinished (callbackEnd);
+
+    return true;
+}
+
+
+void AudioRecorder::flush (PreRollBuffer& buffer)
+{
+    const sf::Int16* samples;
+    std::size_t samplesCount = buffer.oldestPart (samples);
+
+    writer->write (samples, samplesCount, writerInput);
+    _samplesCount += samplesCount;
+
+    samplesCount = buffer.newestPart (samples);
+
+    writer->write (samples, samplesCount, writerInput);
+    _samplesCount += samplesCount;
+
+    buffer.clear ();
+}
+
+bool AudioRecorder::passGate (const sf::Int16* samples, std::size_t samplesCount, const AudioLevels& levels)  // False if the chunk is silence, it is then only kept in the look-back
+{
+    bool open = silenceGate.process (levels.level (), double (samplesCount) / getChannelCount () / getSampleRate ());
+
+    if (skippedRanges.size () == maxSkippedRanges)  // No more room to log the gaps, better keep everything
+        open = true;
+
+    if (open && !gateOpen)
+    {
+        SkippedRange range = {_samplesCount / getChannelCount (), gateClosedAt, capturedFrames - gateLookBack.size () / getChannelCount ()};
+
+        if (range.captureEnd > range.captureStart)
+            skippedRanges.push_back (range);
+
+        flush (gateLookBack);
+    }
+    else if (!open && gateOpen)
+    {
+        gateClosedAt = capturedFrames;
+        gateLookBack.clear ();
+    }
+
+    if (!open)
+        gateLookBack.store (samples, samplesCount);
+
+    gateOpen = open;
+
+    return open;
+}
+
+void AudioRecorder::writeTimings ()  // Appended to a log in the working directory, proves whether a recording had dropouts
+{
+    std::ofstream file ("Capture log.txt", std::ios::app);
+
+    if (!file)
+        return;
+
+    file << QDateTime::currentDateTime ().toString (Qt::ISODate).toStdString () << " " << getDevice () << " -> "
+         << (writer == &ownWriter ? outputFileName : std::string ("shared file")) << "\n"
+         << _timings.report ()
+         << "memory : peak " << memoryPeak () / 1024 << " KB, " << dropEvents () << " drops (" << droppedFrames () << " frames lost)\n" << std::endl;
+}
+
+void AudioRecorder::writeSkippedRanges ()  // Saved next to the recording so the original timing can be rebuilt
+{
+    if (!gateOpen)
+        skippedRanges.push_back ({_samplesCount / getChannelCount (), gateClosedAt, capturedFrames});
+
+    if (skippedRanges.empty () || outputFileName.empty ())
+        return;
+
+    std::ofstream file (outputFileName + ".silences.txt");
+
+    if (!file)
+        return;
+
+    double sampleRate = getSampleRate ();
+
+    file << "# Silences skipped while recording, in seconds" << std::endl;
+    file << "# Position in file\tCapture start\tCapture end" << std::endl;
+
+    for (const SkippedRange& range : skippedRanges)
+        file << range.outputFrame / sampleRate << "\t" << range.captureStart / sampleRate << "\t" << range.captureEnd / sampleRate << std::endl;
+}
+
+bool AudioRecorder::align (const sf::Int16*& samples, std::size_t& samplesCount, std::chrono::steady_clock::time_point callbackTime)  // False if the whole chunk is before the alignment time
+{
+    if (writing && alignmentPending)  // A monitored recorder is aligned with its pre-roll, when it starts writing
+    {
+        alignmentPending = false;
+
+        // The first sample of this chunk was captured one chunk duration before the callback
+        double chunkDuration = double (samplesCount) / getChannelCount () / getSampleRate ();
+        double offset = std::chrono::duration<double> (alignment - callbackTime).count () + chunkDuration;
+        long long int offsetFrames = std::llround (offset * getSampleRate ());
+
+        if (offsetFrames > 0)
+            framesToSkip = offsetFrames;
+
+        else
+            writeSilence (-offsetFrames * getChannelCount ());
+    }
+
+    if (framesToSkip)
+    {
+        std::size_t skippedFrames = std::min<unsigned long long int> (framesToSkip, samplesCount / getChannelCount ());
+
+        framesToSkip -= skippedFrames;
+        samples += skippedFrames * getChannelCount ();
+        samplesCount -= skippedFrames * getChannelCount ();
+    }
+
+    return samplesCount != 0;
+}
+
+void AudioRecorder::alignPreRoll (std::size_t samplesCount, std::chrono::steady_clock::time_point callbackTime)  // Same as align, for a pre-roll followed by this chunk
+{
+    alignmentPending = false;
+
+    // The pre-roll ends where this chunk starts, one chunk duration before the callback
+    double chunkDuration = double (samplesCount) / getChannelCount () / getSampleRate ();
+    double preRollDuration = double (preRollBuffer.size ()) / getChannelCount () / getSampleRate ();
+    double offset = std::chrono::duration<double> (alignment - callbackTime).count () + chunkDuration + preRollDuration;
+    long long int offsetFrames = std::llround (offset * getSampleRate ());
+
+    if (offsetFrames < 0)  // Less pre-roll than the other devices
+    {
+        writeSilence (-offsetFrames * getChannelCount ());
+        return;
+    }
+
+    unsigned long long int droppedFrames = std::min<unsigned long long int> (offsetFrames, preRollBuffer.size () / getChannelCount ());
+
+    preRollBuffer.dropOldest (droppedFrames * getChannelCount ());
+    framesToSkip = offsetFrames - droppedFrames;
+}
+
+void AudioRecorder::writeSilence (std::size_t samplesCount)
+{
+    while (samplesCount != 0)
+    {
+        std::size_t writtenSamples = std::min (samplesCount, silence.size ());
+
+        writer->write (&silence[0], writtenSamples, writerInput);
+
+        _samplesCount += writtenSamples;
+        samplesCount -= writtenSamples;
+    }
+}
@@ -1,55 +1,161 @@
-#ifndef AUDIORECORDER_H
-#define AUDIORECORDER_H
-
-
-#include <SFML/Audio.hpp>
-
-#include <QObject>
-
-
-class AudioRecorder : public QObject, public sf::SoundRecorder
-{
-    Q_OBJECT
-
-    public:
-        AudioRecorder ();
-        virtual ~AudioRecorder ();
-
-
-        void pause ();
-        void resume ();
-
-        bool paused ();
-        bool recording ();
-
-        bool setOutputStream (std::string, unsigned int, unsigned int);
-        void setVolume (unsigned short int);
-
-        unsigned int durationAsMilliseconds ();
-
-
-    signals:
-        void started ();
-
-        void audioLevel (double);
-
-
-    private:
-        virtual bool onProcessSamples (const sf::Int16*, std::size_t);
-        virtual void onStop ();
-        virtual bool onStart ();
-
-        double computeLevel (const short int[], std::size_t);
-
-
-        bool _paused;
-        bool _recording;
-
-        unsigned long long int _samplesCount;
-        unsigned short int _volume;
-
-        sf::OutputSoundFile outputStream;
-};
-
-
-#endif // AUDIORECORDER_H
+#ifndef AUDIORECORDER_H
+#define AUDIORECORDER_H
+
+
+#include <SFML/Audio.hpp>
+
+#include <QObject>
+
+#include <chrono>
+
+#include "SamplesWriter.h"
+#include "AudioLevels.h"
+#include "SeqLock.h"
+#include "PreRollBuffer.h"
+#include "SilenceGate.h"
+#include "Limiter.h"
+#include "CaptureTimings.h"
+#include "SpectrumAnalyzer.h"
+#include "MeterBallistics.h"
+
+
+class AudioRecorder : public QObject, public sf::SoundRecorder
+{
+    Q_OBJECT
+
+    public:
+        enum OverloadProtection
+        {
+            Clipping,
+            Limiting,
+            AutomaticGain
+        };
+
+
+        AudioRecorder ();
+        virtual ~AudioRecorder ();
+
+
+        void pause ();
+        void resume ();
+
+        bool paused ();
+        bool recording ();
+        bool monitoring ();
+
+        void setPreRoll (unsigned int);
+        bool monitor (unsigned int);
+        void record ();
+
+        bool setOutputStream (std::string, unsigned int, unsigned int);
+        void setVolume (unsigned short int);
+        void setOverloadProtection (OverloadProtection);
+        void setBufferDuration (unsigned int);
+        void setLatency (unsigned int);
+        void setSilenceGate (bool, float, unsigned int);
+        void setSegmentLimits (unsigned int, unsigned long long int);
+        void setMemoryBudget (unsigned int);
+        void setSpectrumAnalysis (bool);
+
+        void shareWriter (SamplesWriter*, unsigned short int);
+        void alignTo (std::chrono::steady_clock::time_point);
+
+        std::size_t bufferHighWaterMark ();
+        unsigned int bufferOverruns ();
+        unsigned long long int memoryUsed ();
+        unsigned long long int memoryPeak ();
+        unsigned long long int droppedFrames ();
+        unsigned int dropEvents ();
+
+        double callbacksPerSecond ();
+        double processingLoad ();
+        const CaptureTimings& timings ();
+
+        unsigned int durationAsMilliseconds ();
+
+        AudioLevels levels (unsigned int* = nullptr);
+        SpectrumBands spectrum (unsigned int* = nullptr);
+        std::size_t spectrumColumns (float*, std::size_t, unsigned short int&);
+
+        const std::vector<std::string>& outputFiles ();
+
+
+    signals:
+        void started ();
+        void segmentCompleted (const QString&);
+
+
+    private:
+        virtual bool onProcessSamples (const sf::Int16*, std::size_t);
+        virtual void onStop ();
+        virtual bool onStart ();
+
+        bool align (const sf::Int16*&, std::size_t&, std::chrono::steady_clock::time_point);
+        void alignPreRoll (std::size_t, std::chrono::steady_clock::time_point);
+        void writeSilence (std::size_t);
+        void beginRecording ();
+        void flush (PreRollBuffer&);
+        bool passGate (const sf::Int16*, std::size_t, const AudioLevels&);
+        void writeSkippedRanges ();
+        void writeTimings ();
+
+
+        struct SkippedRange  // In frames, position in the output file then range of the capture timeline
+        {
+            unsigned long long int outputFrame;
+            unsigned long long int captureStart;
+            unsigned long long int captureEnd;
+        };
+
+
+        bool _paused;
+        bool _recording;
+        bool _monitoring;
+
+        std::atomic<bool> recordRequested;
+        bool writing;  // Only touched by the capture thread once started
+
+        unsigned int _preRoll;
+        PreRollBuffer preRollBuffer;
+
+        bool _silenceGate;
+        bool gating;
+        bool gateOpen;
+        SilenceGate silenceGate;
+        PreRollBuffer gateLookBack;
+        unsigned long long int capturedFrames;
+        unsigned long long int gateClosedAt;
+        std::vector<SkippedRange> skippedRanges;
+        std::string outputFileName;
+
+        unsigned long long int _samplesCount;
+        unsigned short int _volume;
+        OverloadProtection _overloadProtection;
+        Limiter limiter;
+        unsigned int _latency;
+
+        std::chrono::steady_clock::time_point startTime;
+        std::atomic<unsigned long long int> callbacksCount;
+        std::atomic<unsigned long long int> processingNanoseconds;
+        CaptureTimings _timings;
+
+        std::vector<sf::Int16> amplifiedSamples;
+        MeterBallistics ballistics;
+        SeqLock<AudioLevels> levelsSnapshot;
+
+        bool _spectrumAnalysis;
+        bool analyzing;  // Only touched by the capture thread once started
+        SpectrumAnalyzer analyzer;
+
+        SamplesWriter ownWriter;
+        SamplesWriter* writer;
+        unsigned short int writerInput;
+
+        bool alignmentPending;
+        std::chrono::steady_clock::time_point alignment;
+        unsigned long long int framesToSkip;
+        std::vector<sf::Int16> silence;
+};
+
+
+#endif // AUDIORECORDER_H
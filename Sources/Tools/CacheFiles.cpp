@@ -0,0 +1,58 @@
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QCryptographicHash>
+
+#include "CacheFiles.h"
+
+
+static const char* cacheFolder = "Cache";
+static const char* extensions[] = {"peaks", "seek"};
+
+
+QString CacheFiles::path (const QString& recording, const QString& extension)
+{
+    QDir ().mkpath (cacheFolder);
+
+    QByteArray key = QCryptographicHash::hash (QFileInfo (recording).absoluteFilePath ().toUtf8 (), QCryptographicHash::Sha1).toHex ();
+
+    return QString (cacheFolder) + "/" + QString::fromLatin1 (key) + "." + extension;
+}
+
+
+bool CacheFiles::matches (const QString& recording, unsigned long long int size, long long int modified)
+{
+    unsigned long long int currentSize;
+    long long int currentModified;
+
+    recordingState (recording, currentSize, currentModified);
+
+    return currentModified != 0 && currentSize == size && currentModified == modified;
+}
+
+void CacheFiles::recordingState (const QString& recording, unsigned long long int& size, long long int& modified)  // 0 for a missing file
+{
+    QFileInfo info (recording);
+
+    size = info.exists () ? info.size () : 0;
+    modified = info.exists () ? info.lastModified ().toMSecsSinceEpoch () : 0;
+}
+
+
+void CacheFiles::rename (const QString& oldRecording, const QString& newRecording)  // The recording keeps its size and date, its cache stays valid
+{
+    for (const char* extension : extensions)
+    {
+        QString newPath = path (newRecording, extension);
+
+        QFile::remove (newPath);
+        QFile::rename (path (oldRecording, extension), newPath);
+    }
+}
+
+void CacheFiles::remove (const QString& recording)
+{
+    for (const char* extension : extensions)
+        QFile::remove (path (recording, extension));
+}
@@ -0,0 +1,23 @@
+#ifndef CACHEFILES_H
+#define CACHEFILES_H
+
+
+#include <QString>
+
+
+// Data derived from a recording is kept in the "Cache" folder, one file per recording and kind, named after its absolute path
+// Each one records the size and modification date of the recording it was built from, so a changed file is detected
+
+namespace CacheFiles
+{
+    QString path (const QString&, const QString&);  // Recording and extension, the folder is created if needed
+
+    bool matches (const QString&, unsigned long long int, long long int);  // Recording, size and modification time it was built from
+    void recordingState (const QString&, unsigned long long int&, long long int&);
+
+    void rename (const QString&, const QString&);  // Follow a renamed recording
+    void remove (const QString&);
+}
+
+
+#endif // CACHEFILES_H
@@ -0,0 +1,145 @@
+#include <cmath>
+#include <sstream>
+#include <iomanip>
+
+#include "CaptureTimings.h"
+
+
+static const double gapThreshold = 0.05;  // Seconds the capture must suddenly fall behind to count a gap, above the usual scheduling noise
+static const double lagSmoothing = 0.001;  // Weight of each callback in the average lag, follows the slow drift between sound card and system clocks
+
+
+CaptureTimings::CaptureTimings ()
+{
+    reset (44100);
+}
+
+
+void CaptureTimings::reset (unsigned int rate)  // Not thread safe, call it before the capture starts
+{
+    sampleRate = std::max (1U, rate);
+
+    _durations.clear ();
+    _intervals.clear ();
+    _jitter.clear ();
+
+    _gaps = 0;
+    _lostFrames = 0;
+    _lateCallbacks = 0;
+
+    firstCallback = true;
+    previousChunkDuration = 0;
+    receivedFrames = 0;
+    averageLag = 0;
+}
+
+
+////////////////////////////////////////  Capture thread
+
+
+void CaptureTimings::callbackStarted (std::chrono::steady_clock::time_point now, std::size_t framesCount)
+{
+    double chunkDuration = double (framesCount) / sampleRate;
+
+    callbackStart = now;
+
+    if (firstCallback)
+    {
+        // The first sample of this chunk was captured one chunk duration ago
+        timelineStart = now - std::chrono::duration_cast<std::chrono::steady_clock::duration> (std::chrono::duration<double> (chunkDuration));
+        firstCallback = false;
+    }
+    else
+    {
+        double interval = std::chrono::duration<double> (now - previousCallback).count ();
+
+        _intervals.add (std::llround (interval * 1e6));
+        _jitter.add (std::llround (std::abs (interval - chunkDuration) * 1e6));
+
+        if (interval > 2 * std::max (chunkDuration, previousChunkDuration))
+            _lateCallbacks++;
+    }
+
+    receivedFrames += framesCount;
+
+
+    double lag = std::chrono::duration<double> (now - timelineStart).count () - double (receivedFrames) / sampleRate;
+
+    if (lag - averageLag > gapThreshold)
+    {
+        _gaps++;
+        _lostFrames += std::llround ((lag - averageLag) * sampleRate);
+
+        averageLag = lag;  // Start again from the new position
+    }
+    else
+        averageLag += (lag - averageLag) * lagSmoothing;
+
+    previousCallback = now;
+    previousChunkDuration = chunkDuration;
+}
+
+void CaptureTimings::callbackFinished (std::chrono::steady_clock::time_point now)
+{
+    _durations.add (std::chrono::duration_cast<std::chrono::microseconds> (now - callbackStart).count ());
+}
+
+
+////////////////////////////////////////  Others
+
+
+const TimingHistogram& CaptureTimings::durations () const
+{
+    return _durations;
+}
+
+const TimingHistogram& CaptureTimings::intervals () const
+{
+    return _intervals;
+}
+
+const TimingHistogram& CaptureTimings::jitter () const
+{
+    return _jitter;
+}
+
+
+unsigned int CaptureTimings::gaps () const
+{
+    return _gaps;
+}
+
+unsigned long long int CaptureTimings::lostFrames () const
+{
+    return _lostFrames;
+}
+
+unsigned int CaptureTimings::lateCallbacks () const
+{
+    return _lateCallbacks;
+}
+
+
+std::string CaptureTimings::report () const  // Text summary with the full histograms, in microseconds
+{
+    std::ostringstream text;
+
+    text << "callbacks " << _durations.count () << ", gaps " << gaps () << " (" << lostFrames () << " frames lost), late callbacks " << lateCallbacks () << "\n";
+
+    const TimingHistogram* histograms[3] = {&_durations, &_intervals, &_jitter};
+    const char* names[3] = {"duration", "interval", "jitter"};
+
+    for (unsigned short int i = 0 ; i != 3 ; i++)
+    {
+        text << names[i] << " : mean " << std::fixed << std::setprecision (1) << histograms[i]->mean ()
+             << ", 99% below " << histograms[i]->percentile (0.99) << ", max " << histograms[i]->maximum () << "\n ";
+
+        for (unsigned short int bucket = 0 ; bucket != TimingHistogram::bucketsCount ; bucket++)
+            if (histograms[i]->bucket (bucket) != 0)
+                text << " <" << TimingHistogram::bucketLimit (bucket) << ":" << histograms[i]->bucket (bucket);
+
+        text << "\n";
+    }
+
+    return text.str ();
+}
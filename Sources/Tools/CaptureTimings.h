@@ -0,0 +1,58 @@
+#ifndef CAPTURETIMINGS_H
+#define CAPTURETIMINGS_H
+
+
+#include <chrono>
+#include <string>
+
+#include "TimingHistogram.h"
+
+
+// Timing of the capture callbacks : how long they last, how regularly they come, and whether the device lost audio
+// A gap is detected when the samples received fall behind the monotonic clock much faster than the usual clock drift
+
+class CaptureTimings
+{
+    public:
+        CaptureTimings ();
+
+
+        void reset (unsigned int);
+
+        void callbackStarted (std::chrono::steady_clock::time_point, std::size_t);
+        void callbackFinished (std::chrono::steady_clock::time_point);
+
+        const TimingHistogram& durations () const;
+        const TimingHistogram& intervals () const;
+        const TimingHistogram& jitter () const;
+
+        unsigned int gaps () const;
+        unsigned long long int lostFrames () const;
+        unsigned int lateCallbacks () const;
+
+        std::string report () const;
+
+
+    private:
+        unsigned int sampleRate;
+
+        TimingHistogram _durations;
+        TimingHistogram _intervals;
+        TimingHistogram _jitter;
+
+        std::atomic<unsigned int> _gaps;
+        std::atomic<unsigned long long int> _lostFrames;
+        std::atomic<unsigned int> _lateCallbacks;
+
+        // Only used by the capture thread
+        bool firstCallback;
+        std::chrono::steady_clock::time_point callbackStart;
+        std::chrono::steady_clock::time_point previousCallback;
+        std::chrono::steady_clock::time_point timelineStart;
+        double previousChunkDuration;
+        unsigned long long int receivedFrames;
+        double averageLag;
+};
+
+
+#endif // CAPTURETIMINGS_H
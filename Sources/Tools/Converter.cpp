@@ -1,61 +1,80 @@
-#include "Converter.h"
-
-
-Converter::Converter () : QThread () { }
-
-
-void Converter::convert (const QStringList& files, const QStringList& outputFiles, unsigned int speed)
-{
-    maxCount = speed;
-
-    this->files = files;
-    this->outputFiles = outputFiles;
-
-
-    start ();
-}
-
-void Converter::run ()
-{
-    short int samples [maxCount];
-
-    for (unsigned short int i = 0 ; i != files.length () ; i++)
-    {
-        emit nextFile (files.at (i));
-        emit progress (0);
-
-        inputStream.openFromFile (std::string (files.at (i).toLocal8Bit ()));
-        outputStream.openFromFile (std::string (outputFiles.at (i).toLocal8Bit ()), inputStream.getSampleRate (), inputStream.getChannelCount ());
-
-        writeFile (&samples[0]);
-    }
-
-    inputStream.openFromFile ("");
-    outputStream.openFromFile ("", 0, 0);
-
-    emit finishedConverting (outputFiles);
-}
-
-void Converter::writeFile (short int samples[])
-{
-    currentProgression = 0;
-
-    short int readSamples = inputStream.read (&samples[0], maxCount);
-    unsigned long long int samplesCount = 0;
-
-
-    while (readSamples != 0)
-    {
-        samplesCount += readSamples;
-        if (double (samplesCount) / double (inputStream.getSampleCount ()) * 100.0 > currentProgression)
-        {
-            currentProgression = double (samplesCount) / double (inputStream.getSampleCount ()) * 100.0;
-
-            emit progress (currentProgression);
-        }
-
-        outputStream.write (&samples[0], readSamples);
-
-        readSamples = inputStream.read (&samples[0], maxCount);
-    }
-}
+#include "Converter.h"
+#include "SoundFileWriters.h"
+
+
+Converter::Converter () : QThread () { }
+
+
+void Converter::convert (const QStringList& files, const QStringList& outputFiles, unsigned int speed, unsigned int sampleRate)
+{
+    maxCount = speed;
+    outputRate = sampleRate;
+
+    this->files = files;
+    this->outputFiles = outputFiles;
+
+
+    start ();
+}
+
+void Converter::run ()
+{
+    short int samples [maxCount];
+
+    for (unsigned short int i = 0 ; i != files.length () ; i++)
+    {
+        emit nextFile (files.at (i));
+        emit progress (0);
+
+        if (!inputStream.openFromFile (std::string (files.at (i).toLocal8Bit ())))
+            continue;
+
+        unsigned int sampleRate = outputRate != 0 ? outputRate : inputStream.getSampleRate ();
+
+        if (!resampler.setup (inputStream.getSampleRate (), sampleRate, inputStream.getChannelCount (), Resampler::defaultQuality ()))
+        {
+            sampleRate = inputStream.getSampleRate ();  // Ratio too complex, the file keeps its rate
+            resampler.setup (sampleRate, sampleRate, inputStream.getChannelCount (), Resampler::defaultQuality ());
+        }
+
+        resampledSamples.resize (resampler.maxOutputSamples (maxCount));
+
+        outputStream = SoundFileWriters::open (std::string (outputFiles.at (i).toLocal8Bit ()), sampleRate, inputStream.getChannelCount ());
+
+        if (outputStream)
+            writeFile (&samples[0]);
+    }
+
+    inputStream.openFromFile ("");
+    outputStream.reset ();
+
+    emit finishedConverting (outputFiles);
+}
+
+void Converter::writeFile (short int samples[])
+{
+    currentProgression = 0;
+
+    unsigned int blockSamples = maxCount - maxCount % inputStream.getChannelCount ();  // Whole frames for the resampler
+
+    short int readSamples = inputStream.read (&samples[0], blockSamples);
+    unsigned long long int samplesCount = 0;
+
+
+    while (readSamples != 0)
+    {
+        samplesCount += readSamples;
+        if (double (samplesCount) / double (inputStream.getSampleCount ()) * 100.0 > currentProgression)
+        {
+            currentProgression = double (samplesCount) / double (inputStream.getSampleCount ()) * 100.0;
+
+            emit progress (currentProgression);
+        }
+
+        outputStream->write (&resampledSamples[0], resampler.process (&samples[0], readSamples, &resampledSamples[0]));
+
+        readSamples = inputStream.read (&samples[0], blockSamples);
+    }
+
+    outputStream->write (&resampledSamples[0], resampler.flush (&resampledSamples[0]));
+}
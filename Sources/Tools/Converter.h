@@ -1,46 +1,55 @@
-#ifndef CONVERTER_H
-#define CONVERTER_H
-
-
-#include <QThread>
-
-#include <SFML/Audio.hpp>
-
-
-class Converter : public QThread
-{
-    Q_OBJECT
-
-    public:
-        Converter ();
-
-        void convert (const QStringList&, const QStringList&, unsigned int);
-
-
-    signals:
-        void duplicateFile (QString&, bool&);
-
-        void progress (unsigned short int);
-
-        void nextFile (const QString&);
-        void finishedConverting (const QStringList&);
-
-
-    private:
-        virtual void run () override;
-
-        void writeFile (short int[]);
-
-
-        unsigned int maxCount;
-        unsigned short int currentProgression;
-
-        QStringList files;
-        QStringList outputFiles;
-
-        sf::InputSoundFile inputStream;
-        sf::OutputSoundFile outputStream;
-};
-
-
-#endif // CONVERTER_H
+#ifndef CONVERTER_H
+#define CONVERTER_H
+
+
+#include <QThread>
+
+#include <SFML/Audio.hpp>
+
+#include <memory>
+#include <vector>
+
+#include "Resampler.h"
+
+
+class Converter : public QThread
+{
+    Q_OBJECT
+
+    public:
+        Converter ();
+
+        void convert (const QStringList&, const QStringList&, unsigned int, unsigned int = 0);  // Files, output files, samples per block and output rate, 0 to keep the rate of each file
+
+
+    signals:
+        void duplicateFile (QString&, bool&);
+
+        void progress (unsigned short int);
+
+        void nextFile (const QString&);
+        void finishedConverting (const QStringList&);
+
+
+    private:
+        virtual void run () override;
+
+        void writeFile (short int[]);
+
+
+        unsigned int maxCount;
+        unsigned int outputRate;
+        unsigned short int currentProgression;
+
+        QStringList files;
+        QStringList outputFiles;
+
+        sf::InputSoundFile inputStream;
+        std::unique_ptr<sf::SoundFileWriter> outputStream;
+
+        Resampler resampler;
+        std::vector<sf::Int16> resampledSamples;
+};
+
+
+#endif // CONVERTER_H
@@ -0,0 +1,254 @@
+#include <cmath>
+
+#include "FFT.h"
+
+#if defined (__x86_64__) || defined (_M_X64) || defined (__i386__) || defined (_M_IX86)
+    #define FFT_X86
+    #include <immintrin.h>
+#endif
+
+
+static const double pi = 3.14159265358979323846;
+
+
+////////////////////////////////////////  Butterflies of one stage, half is the distance between the two inputs
+
+
+static void stageScalar (float* real, float* imag, const float* twiddleReal, const float* twiddleImag, unsigned int count, unsigned int half)
+{
+    for (unsigned int start = 0 ; start != count ; start += 2 * half)
+    {
+        float* firstReal = real + start;
+        float* firstImag = imag + start;
+        float* secondReal = firstReal + half;
+        float* secondImag = firstImag + half;
+
+        for (unsigned int j = 0 ; j != half ; j++)
+        {
+            float productReal = twiddleReal[j] * secondReal[j] - twiddleImag[j] * secondImag[j];
+            float productImag = twiddleReal[j] * secondImag[j] + twiddleImag[j] * secondReal[j];
+
+            secondReal[j] = firstReal[j] - productReal;
+            secondImag[j] = firstImag[j] - productImag;
+            firstReal[j] += productReal;
+            firstImag[j] += productImag;
+        }
+    }
+}
+
+#ifdef FFT_X86
+
+#if defined (__GNUC__) || defined (__clang__)
+__attribute__ ((target ("sse2")))
+#endif
+static void stageSSE2 (float* real, float* imag, const float* twiddleReal, const float* twiddleImag, unsigned int count, unsigned int half)  // half must be a multiple of 4
+{
+    for (unsigned int start = 0 ; start != count ; start += 2 * half)
+    {
+        float* firstReal = real + start;
+        float* firstImag = imag + start;
+        float* secondReal = firstReal + half;
+        float* secondImag = firstImag + half;
+
+        for (unsigned int j = 0 ; j != half ; j += 4)
+        {
+            __m128 wr = _mm_loadu_ps (twiddleReal + j);
+            __m128 wi = _mm_loadu_ps (twiddleImag + j);
+            __m128 br = _mm_loadu_ps (secondReal + j);
+            __m128 bi = _mm_loadu_ps (secondImag + j);
+            __m128 ar = _mm_loadu_ps (firstReal + j);
+            __m128 ai = _mm_loadu_ps (firstImag + j);
+
+            __m128 productReal = _mm_sub_ps (_mm_mul_ps (wr, br), _mm_mul_ps (wi, bi));
+            __m128 productImag = _mm_add_ps (_mm_mul_ps (wr, bi), _mm_mul_ps (wi, br));
+
+            _mm_storeu_ps (secondReal + j, _mm_sub_ps (ar, productReal));
+            _mm_storeu_ps (secondImag + j, _mm_sub_ps (ai, productImag));
+            _mm_storeu_ps (firstReal + j, _mm_add_ps (ar, productReal));
+            _mm_storeu_ps (firstImag + j, _mm_add_ps (ai, productImag));
+        }
+    }
+}
+
+#if defined (__GNUC__) || defined (__clang__)
+__attribute__ ((target ("avx2")))
+#endif
+static void stageAVX2 (float* real, float* imag, const float* twiddleReal, const float* twiddleImag, unsigned int count, unsigned int half)  // half must be a multiple of 8
+{
+    for (unsigned int start = 0 ; start != count ; start += 2 * half)
+    {
+        float* firstReal = real + start;
+        float* firstImag = imag + start;
+        float* secondReal = firstReal + half;
+        float* secondImag = firstImag + half;
+
+        for (unsigned int j = 0 ; j != half ; j += 8)
+        {
+            __m256 wr = _mm256_loadu_ps (twiddleReal + j);
+            __m256 wi = _mm256_loadu_ps (twiddleImag + j);
+            __m256 br = _mm256_loadu_ps (secondReal + j);
+            __m256 bi = _mm256_loadu_ps (secondImag + j);
+            __m256 ar = _mm256_loadu_ps (firstReal + j);
+            __m256 ai = _mm256_loadu_ps (firstImag + j);
+
+            __m256 productReal = _mm256_sub_ps (_mm256_mul_ps (wr, br), _mm256_mul_ps (wi, bi));
+            __m256 productImag = _mm256_add_ps (_mm256_mul_ps (wr, bi), _mm256_mul_ps (wi, br));
+
+            _mm256_storeu_ps (secondReal + j, _mm256_sub_ps (ar, productReal));
+            _mm256_storeu_ps (secondImag + j, _mm256_sub_ps (ai, productImag));
+            _mm256_storeu_ps (firstReal + j, _mm256_add_ps (ar, productReal));
+            _mm256_storeu_ps (firstImag + j, _mm256_add_ps (ai, productImag));
+        }
+    }
+}
+
+#endif // FFT_X86
+
+
+typedef void (*StageFunction) (float*, float*, const float*, const float*, unsigned int, unsigned int);
+
+struct StageImplementation
+{
+    StageFunction function;
+    unsigned int width;  // Smallest half length it can handle, narrower stages use the scalar code
+    const char* name;
+};
+
+static StageImplementation selectImplementation ()
+{
+    #ifdef FFT_X86
+        #if defined (__GNUC__) || defined (__clang__)
+            __builtin_cpu_init ();
+
+            if (__builtin_cpu_supports ("avx2"))
+                return {stageAVX2, 8, "AVX2"};
+
+            if (__builtin_cpu_supports ("sse2"))
+                return {stageSSE2, 4, "SSE2"};
+        #else
+            return {stageSSE2, 4, "SSE2"};
+        #endif
+    #endif
+
+    return {stageScalar, 1, "scalar"};
+}
+
+static const StageImplementation selectedImplementation = selectImplementation ();
+
+
+////////////////////////////////////////  Plan
+
+
+RealFFT::RealFFT ()
+{
+    _size = 0;
+    halfSize = 0;
+}
+
+
+bool RealFFT::setup (unsigned int newSize)
+{
+    if (newSize < 16 || newSize > 65536 || (newSize & (newSize - 1)) != 0)
+        return false;
+
+    _size = newSize;
+    halfSize = newSize / 2;
+
+
+    unsigned int bits = 0;
+
+    while ((1U << bits) != halfSize)
+        bits++;
+
+    bitReversed.resize (halfSize);
+
+    for (unsigned int i = 0 ; i != halfSize ; i++)
+    {
+        unsigned int reversed = 0;
+
+        for (unsigned int bit = 0 ; bit != bits ; bit++)
+            reversed |= ((i >> bit) & 1) << (bits - 1 - bit);
+
+        bitReversed[i] = reversed;
+    }
+
+
+    twiddleReal.assign (halfSize, 0);
+    twiddleImag.assign (halfSize, 0);
+
+    for (unsigned int half = 1 ; half != halfSize ; half *= 2)
+        for (unsigned int j = 0 ; j != half ; j++)
+        {
+            twiddleReal[half + j] = std::cos (pi * j / half);
+            twiddleImag[half + j] = -std::sin (pi * j / half);
+        }
+
+    splitReal.resize (halfSize);
+    splitImag.resize (halfSize);
+
+    for (unsigned int k = 0 ; k != halfSize ; k++)
+    {
+        splitReal[k] = std::cos (2 * pi * k / _size);
+        splitImag[k] = -std::sin (2 * pi * k / _size);
+    }
+
+    real.assign (halfSize, 0);
+    imag.assign (halfSize, 0);
+
+    return true;
+}
+
+unsigned int RealFFT::size () const
+{
+    return _size;
+}
+
+
+////////////////////////////////////////  Transform
+
+
+void RealFFT::powerSpectrum (const float* samples, float* power)
+{
+    for (unsigned int i = 0 ; i != halfSize ; i++)  // Even samples as real part and odd ones as imaginary part, already in butterfly order
+    {
+        real[bitReversed[i]] = samples[2 * i];
+        imag[bitReversed[i]] = samples[2 * i + 1];
+    }
+
+    transform ();
+
+
+    power[0] = (real[0] + imag[0]) * (real[0] + imag[0]);
+    power[halfSize] = (real[0] - imag[0]) * (real[0] - imag[0]);
+
+    for (unsigned int k = 1 ; k != halfSize ; k++)
+    {
+        unsigned int mirror = halfSize - k;
+
+        float evenReal = 0.5f * (real[k] + real[mirror]);
+        float evenImag = 0.5f * (imag[k] - imag[mirror]);
+        float oddReal = 0.5f * (imag[k] + imag[mirror]);
+        float oddImag = 0.5f * (real[mirror] - real[k]);
+
+        float binReal = evenReal + splitReal[k] * oddReal - splitImag[k] * oddImag;
+        float binImag = evenImag + splitReal[k] * oddImag + splitImag[k] * oddReal;
+
+        power[k] = binReal * binReal + binImag * binImag;
+    }
+}
+
+void RealFFT::transform ()
+{
+    for (unsigned int half = 1 ; half != halfSize ; half *= 2)
+    {
+        StageFunction stage = half >= selectedImplementation.width ? selectedImplementation.function : stageScalar;
+
+        stage (&real[0], &imag[0], &twiddleReal[half], &twiddleImag[half], halfSize, half);
+    }
+}
+
+
+const char* RealFFT::implementation ()
+{
+    return selectedImplementation.name;
+}
@@ -0,0 +1,42 @@
+#ifndef FFT_H
+#define FFT_H
+
+
+#include <vector>
+
+
+// Real input FFT, planned once per size : a complex radix-2 transform of half the size on split real / imaginary arrays,
+// then one pass separating the even and odd parts, so a transform never allocates and the butterflies run 4 or 8 at a time
+
+class RealFFT
+{
+    public:
+        RealFFT ();
+
+        bool setup (unsigned int);  // Power of two, from 16 to 65536
+        unsigned int size () const;
+
+        void powerSpectrum (const float*, float*);  // size () samples in, size () / 2 + 1 squared magnitudes out
+
+        static const char* implementation ();  // Name of the code path selected for this CPU
+
+
+    private:
+        void transform ();
+
+
+        unsigned int _size;
+        unsigned int halfSize;
+
+        std::vector<unsigned int> bitReversed;
+        std::vector<float> twiddleReal;  // Stage of half length h uses the entries h to 2h - 1
+        std::vector<float> twiddleImag;
+        std::vector<float> splitReal;  // Rotation between the halves of the packed spectrum, per bin
+        std::vector<float> splitImag;
+
+        std::vector<float> real;
+        std::vector<float> imag;
+};
+
+
+#endif // FFT_H
@@ -0,0 +1,252 @@
+#include <algorithm>
+
+#include "FlacReader.h"
+
+
+FlacReader::FlacReader (const SeekIndex* seekIndex)
+{
+    index = seekIndex;
+
+    stream = nullptr;
+    decoder = nullptr;
+
+    sampleRate = 0;
+    channelCount = 0;
+    bitsPerSample = 16;
+    totalFrames = 0;
+
+    decodedPosition = 0;
+
+    skipping = false;
+    overshot = false;
+    skipTarget = 0;
+}
+
+FlacReader::~FlacReader ()
+{
+    close ();
+}
+
+
+////////////////////////////////////////  SFML reader interface
+
+
+bool FlacReader::open (sf::InputStream& inputStream, Info& info)
+{
+    close ();
+
+    stream = &inputStream;
+    decoder = FLAC__stream_decoder_new ();
+
+    if (decoder == nullptr ||
+        FLAC__stream_decoder_init_stream (decoder, &readCallback, &seekCallback, &tellCallback, &lengthCallback, &eofCallback,
+                                          &writeCallback, &metadataCallback, &errorCallback, this) != FLAC__STREAM_DECODER_INIT_STATUS_OK ||
+        !FLAC__stream_decoder_process_until_end_of_metadata (decoder) || channelCount == 0)
+    {
+        close ();
+        return false;
+    }
+
+    info.channelCount = channelCount;
+    info.sampleRate = sampleRate;
+    info.sampleCount = totalFrames * channelCount;
+
+    return true;
+}
+
+void FlacReader::close ()
+{
+    if (decoder != nullptr)
+    {
+        FLAC__stream_decoder_finish (decoder);
+        FLAC__stream_decoder_delete (decoder);
+    }
+
+    decoder = nullptr;
+    stream = nullptr;
+
+    channelCount = 0;
+    decoded.clear ();
+    decodedPosition = 0;
+}
+
+
+void FlacReader::seek (sf::Uint64 sampleOffset)
+{
+    unsigned long long int target = sampleOffset / channelCount;
+
+    decoded.clear ();
+    decodedPosition = 0;
+
+    if (seekThroughIndex (target))
+        return;
+
+    skipping = false;
+    decoded.clear ();
+
+    FLAC__stream_decoder_flush (decoder);  // The jump may have left it at the end of the stream
+
+    if (!FLAC__stream_decoder_seek_absolute (decoder, target))  // Its own search, exact too but reading much more
+        FLAC__stream_decoder_flush (decoder);
+}
+
+bool FlacReader::seekThroughIndex (unsigned long long int target)  // One read from the frame before the target, then decoding up to it
+{
+    SeekPoint point;
+
+    if (index == nullptr || !index->find (target, point) || stream->seek (point.offset) != sf::Int64 (point.offset) || !FLAC__stream_decoder_flush (decoder))
+        return false;
+
+    skipping = true;
+    overshot = false;
+    skipTarget = target;
+
+    while (decoded.empty () && !overshot && FLAC__stream_decoder_get_state (decoder) != FLAC__STREAM_DECODER_END_OF_STREAM)
+        if (!FLAC__stream_decoder_process_single (decoder))
+            return false;
+
+    return !overshot;
+}
+
+
+sf::Uint64 FlacReader::read (sf::Int16* samples, sf::Uint64 maxCount)
+{
+    sf::Uint64 count = 0;
+
+    while (count < maxCount)
+    {
+        if (decodedPosition == decoded.size ())
+        {
+            decoded.clear ();
+            decodedPosition = 0;
+
+            if (FLAC__stream_decoder_get_state (decoder) == FLAC__STREAM_DECODER_END_OF_STREAM || !FLAC__stream_decoder_process_single (decoder))
+                break;
+
+            continue;
+        }
+
+        std::size_t copied = std::min<sf::Uint64> (maxCount - count, decoded.size () - decodedPosition);
+
+        std::copy (decoded.begin () + decodedPosition, decoded.begin () + decodedPosition + copied, samples + count);
+        decodedPosition += copied;
+        count += copied;
+    }
+
+    return count;
+}
+
+
+////////////////////////////////////////  libFLAC callbacks
+
+
+FLAC__StreamDecoderReadStatus FlacReader::readCallback (const FLAC__StreamDecoder*, FLAC__byte buffer[], std::size_t* bytes, void* data)
+{
+    sf::Int64 readBytes = static_cast<FlacReader*> (data)->stream->read (buffer, *bytes);
+
+    if (readBytes < 0)
+        return FLAC__STREAM_DECODER_READ_STATUS_ABORT;
+
+    *bytes = std::size_t (readBytes);
+
+    return readBytes == 0 ? FLAC__STREAM_DECODER_READ_STATUS_END_OF_STREAM : FLAC__STREAM_DECODER_READ_STATUS_CONTINUE;
+}
+
+FLAC__StreamDecoderSeekStatus FlacReader::seekCallback (const FLAC__StreamDecoder*, FLAC__uint64 offset, void* data)
+{
+    return static_cast<FlacReader*> (data)->stream->seek (offset) == sf::Int64 (offset) ? FLAC__STREAM_DECODER_SEEK_STATUS_OK : FLAC__STREAM_DECODER_SEEK_STATUS_ERROR;
+}
+
+FLAC__StreamDecoderTellStatus FlacReader::tellCallback (const FLAC__StreamDecoder*, FLAC__uint64* offset, void* data)
+{
+    sf::Int64 position = static_cast<FlacReader*> (data)->stream->tell ();
+
+    if (position < 0)
+        return FLAC__STREAM_DECODER_TELL_STATUS_ERROR;
+
+    *offset = position;
+
+    return FLAC__STREAM_DECODER_TELL_STATUS_OK;
+}
+
+FLAC__StreamDecoderLengthStatus FlacReader::lengthCallback (const FLAC__StreamDecoder*, FLAC__uint64* length, void* data)
+{
+    sf::Int64 size = static_cast<FlacReader*> (data)->stream->getSize ();
+
+    if (size < 0)
+        return FLAC__STREAM_DECODER_LENGTH_STATUS_ERROR;
+
+    *length = size;
+
+    return FLAC__STREAM_DECODER_LENGTH_STATUS_OK;
+}
+
+FLAC__bool FlacReader::eofCallback (const FLAC__StreamDecoder*, void* data)
+{
+    sf::InputStream* stream = static_cast<FlacReader*> (data)->stream;
+
+    return stream->tell () == stream->getSize ();
+}
+
+
+FLAC__StreamDecoderWriteStatus FlacReader::writeCallback (const FLAC__StreamDecoder*, const FLAC__Frame* frame, const FLAC__int32* const buffer[], void* data)
+{
+    FlacReader* reader = static_cast<FlacReader*> (data);
+
+    unsigned int blockSize = frame->header.blocksize;
+    unsigned long long int frameStart = frame->header.number.sample_number;  // libFLAC converts the frame numbers
+    unsigned int first = 0;
+
+    if (reader->skipping)
+    {
+        if (frameStart > reader->skipTarget)
+        {
+            reader->skipping = false;
+            reader->overshot = true;
+
+            return FLAC__STREAM_DECODER_WRITE_STATUS_CONTINUE;
+        }
+
+        first = unsigned (std::min<unsigned long long int> (blockSize, reader->skipTarget - frameStart));
+
+        if (first == blockSize)
+            return FLAC__STREAM_DECODER_WRITE_STATUS_CONTINUE;
+
+        reader->skipping = false;
+    }
+
+
+    unsigned int channels = reader->channelCount;
+    unsigned int bits = reader->bitsPerSample;
+
+    reader->decoded.resize ((blockSize - first) * channels);
+    reader->decodedPosition = 0;
+
+    for (unsigned int i = first ; i != blockSize ; i++)
+        for (unsigned int channel = 0 ; channel != channels ; channel++)
+        {
+            FLAC__int32 sample = buffer[channel][i];
+
+            reader->decoded[(i - first) * channels + channel] = sf::Int16 (bits > 16 ? sample >> (bits - 16) : sample << (16 - bits));
+        }
+
+    return FLAC__STREAM_DECODER_WRITE_STATUS_CONTINUE;
+}
+
+void FlacReader::metadataCallback (const FLAC__StreamDecoder*, const FLAC__StreamMetadata* metadata, void* data)
+{
+    if (metadata->type != FLAC__METADATA_TYPE_STREAMINFO)
+        return;
+
+    FlacReader* reader = static_cast<FlacReader*> (data);
+
+    reader->sampleRate = metadata->data.stream_info.sample_rate;
+    reader->channelCount = metadata->data.stream_info.channels;
+    reader->bitsPerSample = metadata->data.stream_info.bits_per_sample;
+    reader->totalFrames = metadata->data.stream_info.total_samples;
+}
+
+void FlacReader::errorCallback (const FLAC__StreamDecoder*, FLAC__StreamDecoderErrorStatus, void*)
+{
+    // Damaged frames are skipped by the decoder, the playback goes on
+}
@@ -0,0 +1,61 @@
+#ifndef FLACREADER_H
+#define FLACREADER_H
+
+
+#include <SFML/Audio.hpp>
+
+#include <FLAC/stream_decoder.h>
+
+#include <vector>
+
+#include "SeekIndex.h"
+
+
+// FLAC decoder through libFLAC, as the SFML one, except for seeking : with an index of the file
+// it reads from the frame just before the target and drops the samples before it, instead of searching the file
+
+class FlacReader : public sf::SoundFileReader
+{
+    public:
+        explicit FlacReader (const SeekIndex* = nullptr);
+        virtual ~FlacReader ();
+
+        virtual bool open (sf::InputStream&, Info&) override;
+        virtual void seek (sf::Uint64) override;
+        virtual sf::Uint64 read (sf::Int16*, sf::Uint64) override;
+
+
+    private:
+        void close ();
+        bool seekThroughIndex (unsigned long long int);
+
+        static FLAC__StreamDecoderReadStatus readCallback (const FLAC__StreamDecoder*, FLAC__byte[], std::size_t*, void*);
+        static FLAC__StreamDecoderSeekStatus seekCallback (const FLAC__StreamDecoder*, FLAC__uint64, void*);
+        static FLAC__StreamDecoderTellStatus tellCallback (const FLAC__StreamDecoder*, FLAC__uint64*, void*);
+        static FLAC__StreamDecoderLengthStatus lengthCallback (const FLAC__StreamDecoder*, FLAC__uint64*, void*);
+        static FLAC__bool eofCallback (const FLAC__StreamDecoder*, void*);
+        static FLAC__StreamDecoderWriteStatus writeCallback (const FLAC__StreamDecoder*, const FLAC__Frame*, const FLAC__int32* const[], void*);
+        static void metadataCallback (const FLAC__StreamDecoder*, const FLAC__StreamMetadata*, void*);
+        static void errorCallback (const FLAC__StreamDecoder*, FLAC__StreamDecoderErrorStatus, void*);
+
+
+        const SeekIndex* index;
+
+        sf::InputStream* stream;
+        FLAC__StreamDecoder* decoder;
+
+        unsigned int sampleRate;
+        unsigned int channelCount;
+        unsigned int bitsPerSample;
+        unsigned long long int totalFrames;
+
+        std::vector<sf::Int16> decoded;  // Last decoded frame, interleaved
+        std::size_t decodedPosition;
+
+        bool skipping;  // After a jump, the frames before the target are dropped
+        bool overshot;  // The first frame after the jump was already past the target
+        unsigned long long int skipTarget;
+};
+
+
+#endif // FLACREADER_H
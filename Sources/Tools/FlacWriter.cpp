@@ -0,0 +1,657 @@
+#include <cstdint>
+#include <algorithm>
+
+#include <QString>
+
+#include "FlacWriter.h"
+
+
+static const unsigned int standardBlockSize = 4096;  // Coded in the frame headers, other block sizes are written in full
+static const unsigned short int bitsPerSample = 16;
+static const unsigned short int maxFixedOrder = 4;
+static const unsigned short int maxPartitionOrder = 8;
+
+
+////////////////////////////////////////  Bitstream
+
+
+class BitWriter
+{
+    public:
+        explicit BitWriter (std::vector<unsigned char>& output) : bytes (output), accumulator (0), pendingBits (0) { }
+
+        void put (std::uint32_t value, unsigned short int bitsCount)  // Up to 32 bits, most significant first
+        {
+            if (bitsCount == 0)
+                return;
+
+            accumulator = (accumulator << bitsCount) | (value & (0xFFFFFFFFULL >> (32 - bitsCount)));
+            pendingBits += bitsCount;
+
+            while (pendingBits >= 8)
+            {
+                pendingBits -= 8;
+                bytes.push_back ((unsigned char) (accumulator >> pendingBits));
+            }
+        }
+
+        void putRice (std::uint32_t value, unsigned short int parameter)
+        {
+            std::uint32_t quotient = value >> parameter;
+
+            for ( ; quotient >= 32 ; quotient -= 32)
+                put (0, 32);
+
+            put (1, quotient + 1);
+            put (value, parameter);
+        }
+
+        void alignToByte ()
+        {
+            if (pendingBits != 0)
+                put (0, 8 - pendingBits);
+        }
+
+
+    private:
+        std::vector<unsigned char>& bytes;
+
+        std::uint64_t accumulator;
+        unsigned short int pendingBits;
+};
+
+
+struct CrcTables
+{
+    std::uint8_t crc8[256];
+    std::uint16_t crc16[256];
+
+    CrcTables ()
+    {
+        for (unsigned int i = 0 ; i != 256 ; i++)
+        {
+            std::uint8_t crc8Value = i;
+            std::uint16_t crc16Value = i << 8;
+
+            for (unsigned short int bit = 0 ; bit != 8 ; bit++)
+            {
+                crc8Value = (crc8Value & 0x80) ? (crc8Value << 1) ^ 0x07 : crc8Value << 1;
+                crc16Value = (crc16Value & 0x8000) ? (crc16Value << 1) ^ 0x8005 : crc16Value << 1;
+            }
+
+            crc8[i] = crc8Value;
+            crc16[i] = crc16Value;
+        }
+    }
+};
+
+static const CrcTables crcTables;
+
+static std::uint8_t crc8 (const unsigned char* data, std::size_t size)
+{
+    std::uint8_t crc = 0;
+
+    for (std::size_t i = 0 ; i != size ; i++)
+        crc = crcTables.crc8[crc ^ data[i]];
+
+    return crc;
+}
+
+static std::uint16_t crc16 (const unsigned char* data, std::size_t size)
+{
+    std::uint16_t crc = 0;
+
+    for (std::size_t i = 0 ; i != size ; i++)
+        crc = (crc << 8) ^ crcTables.crc16[(crc >> 8) ^ data[i]];
+
+    return crc;
+}
+
+
+////////////////////////////////////////  Subframes
+
+
+// Fixed polynomial predictors of FLAC, order 0 to 4
+
+static void fixedResiduals (const std::int32_t* samples, unsigned int count, unsigned short int order, std::int32_t* residuals)
+{
+    for (unsigned int i = order ; i < count ; i++)
+    {
+        switch (order)
+        {
+            case 0: residuals[i] = samples[i]; break;
+            case 1: residuals[i] = samples[i] - samples[i - 1]; break;
+            case 2: residuals[i] = samples[i] - 2 * samples[i - 1] + samples[i - 2]; break;
+            case 3: residuals[i] = samples[i] - 3 * samples[i - 1] + 3 * samples[i - 2] - samples[i - 3]; break;
+            default: residuals[i] = samples[i] - 4 * samples[i - 1] + 6 * samples[i - 2] - 4 * samples[i - 3] + samples[i - 4];
+        }
+    }
+}
+
+static std::uint32_t foldSign (std::int32_t residual)
+{
+    return (std::uint32_t (residual) << 1) ^ std::uint32_t (residual >> 31);
+}
+
+
+struct RiceCoding
+{
+    unsigned short int partitionOrder;
+    std::vector<unsigned short int> parameters;
+    bool wideParameters;  // 5 bits parameters, needed above 14
+    std::uint64_t bits;
+};
+
+static std::uint64_t riceBits (std::uint64_t sum, unsigned int count, unsigned short int& bestParameter)  // Estimated from the sum of the folded residuals
+{
+    std::uint64_t bestBits = UINT64_MAX;
+
+    for (unsigned short int parameter = 0 ; parameter <= 30 ; parameter++)
+    {
+        std::uint64_t bits = std::uint64_t (count) * (parameter + 1) + (sum >> parameter);
+
+        if (bits < bestBits)
+        {
+            bestBits = bits;
+            bestParameter = parameter;
+        }
+    }
+
+    return bestBits;
+}
+
+static RiceCoding chooseRiceCoding (const std::int32_t* residuals, unsigned int count, unsigned short int order)
+{
+    unsigned short int finestOrder = 0;
+
+    while (finestOrder < maxPartitionOrder && count % (2U << finestOrder) == 0 && (count >> (finestOrder + 1)) > order)
+        finestOrder++;
+
+
+    // Sums of the finest partitions, merged two by two for the coarser orders
+    std::vector<std::uint64_t> sums (1U << finestOrder, 0);
+    unsigned int partitionSize = count >> finestOrder;
+
+    for (unsigned int i = order ; i < count ; i++)
+        sums[i / partitionSize] += foldSign (residuals[i]);
+
+    RiceCoding best;
+    best.bits = UINT64_MAX;
+
+    for (int partitionOrder = finestOrder ; partitionOrder >= 0 ; partitionOrder--)
+    {
+        unsigned int partitions = 1U << partitionOrder;
+        unsigned int size = count >> partitionOrder;
+
+        RiceCoding coding;
+        coding.partitionOrder = partitionOrder;
+        coding.parameters.resize (partitions);
+        coding.wideParameters = false;
+        coding.bits = 0;
+
+        for (unsigned int partition = 0 ; partition != partitions ; partition++)
+        {
+            coding.bits += riceBits (sums[partition], partition == 0 ? size - order : size, coding.parameters[partition]);
+            coding.wideParameters |= coding.parameters[partition] > 14;
+        }
+
+        coding.bits += std::uint64_t (partitions) * (coding.wideParameters ? 5 : 4);
+
+        if (coding.bits < best.bits)
+            best = coding;
+
+        for (unsigned int partition = 0 ; partition != partitions / 2 ; partition++)
+            sums[partition] = sums[2 * partition] + sums[2 * partition + 1];
+    }
+
+    return best;
+}
+
+
+struct Subframe
+{
+    enum Type {Constant, Verbatim, Fixed} type;
+    unsigned short int order;
+    RiceCoding coding;
+    std::uint64_t bits;
+};
+
+static Subframe chooseSubframe (const std::int32_t* samples, unsigned int count, unsigned short int sampleBits, std::vector<std::int32_t>& residuals)
+{
+    Subframe best;
+
+    if (std::all_of (samples, samples + count, [samples] (std::int32_t sample) { return sample == samples[0]; }))
+    {
+        best.type = Subframe::Constant;
+        best.bits = 8 + sampleBits;
+
+        return best;
+    }
+
+    best.type = Subframe::Verbatim;
+    best.bits = 8 + std::uint64_t (count) * sampleBits;
+
+    for (unsigned short int order = 0 ; order <= maxFixedOrder && order < count ; order++)
+    {
+        fixedResiduals (samples, count, order, &residuals[0]);
+
+        RiceCoding coding = chooseRiceCoding (&residuals[0], count, order);
+        std::uint64_t bits = 8 + order * sampleBits + 6 + coding.bits;
+
+        if (bits < best.bits)
+        {
+            best.type = Subframe::Fixed;
+            best.order = order;
+            best.coding = coding;
+            best.bits = bits;
+        }
+    }
+
+    return best;
+}
+
+static void writeSubframe (BitWriter& bits, const std::int32_t* samples, unsigned int count, unsigned short int sampleBits, const Subframe& subframe, std::vector<std::int32_t>& residuals)
+{
+    bits.put (0, 1);
+
+    if (subframe.type == Subframe::Constant)
+    {
+        bits.put (0, 6);
+        bits.put (0, 1);
+        bits.put (samples[0], sampleBits);
+
+        return;
+    }
+
+    if (subframe.type == Subframe::Verbatim)
+    {
+        bits.put (1, 6);
+        bits.put (0, 1);
+
+        for (unsigned int i = 0 ; i != count ; i++)
+            bits.put (samples[i], sampleBits);
+
+        return;
+    }
+
+
+    bits.put (8 | subframe.order, 6);
+    bits.put (0, 1);
+
+    for (unsigned short int i = 0 ; i != subframe.order ; i++)
+        bits.put (samples[i], sampleBits);
+
+    fixedResiduals (samples, count, subframe.order, &residuals[0]);
+
+    const RiceCoding& coding = subframe.coding;
+    unsigned int size = count >> coding.partitionOrder;
+
+    bits.put (coding.wideParameters ? 1 : 0, 2);
+    bits.put (coding.partitionOrder, 4);
+
+    for (unsigned int partition = 0 ; partition != coding.parameters.size () ; partition++)
+    {
+        bits.put (coding.parameters[partition], coding.wideParameters ? 5 : 4);
+
+        for (unsigned int i = std::max (partition * size, (unsigned int) subframe.order) ; i != (partition + 1) * size ; i++)
+            bits.putRice (foldSign (residuals[i]), coding.parameters[partition]);
+    }
+}
+
+
+////////////////////////////////////////  Frames
+
+
+static void writeUtf8 (BitWriter& bits, unsigned long long int value)  // Frame numbers use the UTF-8 scheme extended to 36 bits
+{
+    if (value < 0x80)
+    {
+        bits.put (value, 8);
+        return;
+    }
+
+    unsigned short int extraBytes = 1;
+
+    while (extraBytes < 6 && value >= (1ULL << (5 * extraBytes + 6)))
+        extraBytes++;
+
+    bits.put (((1U << (extraBytes + 1)) - 1) << 1, extraBytes + 2);  // One leading one per byte, then a zero
+    bits.put (value >> (6 * extraBytes), 6 - extraBytes);
+
+    for (int i = extraBytes - 1 ; i >= 0 ; i--)
+        bits.put (0x80 | ((value >> (6 * i)) & 0x3F), 8);
+}
+
+static unsigned short int sampleRateCode (unsigned int sampleRate)
+{
+    switch (sampleRate)
+    {
+        case 88200: return 1;
+        case 176400: return 2;
+        case 192000: return 3;
+        case 8000: return 4;
+        case 16000: return 5;
+        case 22050: return 6;
+        case 24000: return 7;
+        case 32000: return 8;
+        case 44100: return 9;
+        case 48000: return 10;
+        case 96000: return 11;
+        default: return 0;  // Taken from the stream info
+    }
+}
+
+static void encodeFrame (const sf::Int16* samples, unsigned int count, unsigned short int channelCount, unsigned int sampleRate, unsigned long long int number, std::vector<unsigned char>& bytes)
+{
+    std::vector<std::vector<std::int32_t>> channels (channelCount, std::vector<std::int32_t> (count));
+    std::vector<std::int32_t> residuals (count);
+
+    for (unsigned int i = 0 ; i != count ; i++)
+        for (unsigned short int channel = 0 ; channel != channelCount ; channel++)
+            channels[channel][i] = samples[i * channelCount + channel];
+
+
+    // Stereo may be stored as a difference with the mean or one channel, whatever is the smallest
+    unsigned short int assignment = channelCount - 1;
+    std::vector<const std::int32_t*> sources;
+    std::vector<unsigned short int> sourceBits;
+    std::vector<Subframe> subframes;
+
+    if (channelCount == 2)
+    {
+        std::vector<std::int32_t> side (count), mid (count);
+
+        for (unsigned int i = 0 ; i != count ; i++)
+        {
+            side[i] = channels[0][i] - channels[1][i];
+            mid[i] = (channels[0][i] + channels[1][i]) >> 1;
+        }
+
+        Subframe left = chooseSubframe (&channels[0][0], count, bitsPerSample, residuals);
+        Subframe right = chooseSubframe (&channels[1][0], count, bitsPerSample, residuals);
+        Subframe sideSubframe = chooseSubframe (&side[0], count, bitsPerSample + 1, residuals);
+        Subframe midSubframe = chooseSubframe (&mid[0], count, bitsPerSample, residuals);
+
+        std::uint64_t costs[4] = {left.bits + right.bits, left.bits + sideSubframe.bits, sideSubframe.bits + right.bits, midSubframe.bits + sideSubframe.bits};
+        unsigned short int choice = std::min_element (costs, costs + 4) - costs;
+
+        channels.push_back (side);
+        channels.push_back (mid);
+
+        const std::int32_t* sideSamples = &channels[2][0];
+        const std::int32_t* midSamples = &channels[3][0];
+
+        switch (choice)
+        {
+            case 0: sources = {&channels[0][0], &channels[1][0]}; sourceBits = {16, 16}; subframes = {left, right}; break;
+            case 1: sources = {&channels[0][0], sideSamples}; sourceBits = {16, 17}; subframes = {left, sideSubframe}; assignment = 8; break;
+            case 2: sources = {sideSamples, &channels[1][0]}; sourceBits = {17, 16}; subframes = {sideSubframe, right}; assignment = 9; break;
+            default: sources = {midSamples, sideSamples}; sourceBits = {16, 17}; subframes = {midSubframe, sideSubframe}; assignment = 10;
+        }
+    }
+    else
+    {
+        for (unsigned short int channel = 0 ; channel != channelCount ; channel++)
+        {
+            sources.push_back (&channels[channel][0]);
+            sourceBits.push_back (bitsPerSample);
+            subframes.push_back (chooseSubframe (&channels[channel][0], count, bitsPerSample, residuals));
+        }
+    }
+
+
+    bytes.clear ();
+    BitWriter bits (bytes);
+
+    bits.put (0xFFF8, 16);  // Sync code, fixed block size
+    bits.put (count == standardBlockSize ? 12 : count <= 256 ? 6 : 7, 4);
+    bits.put (sampleRateCode (sampleRate), 4);
+    bits.put (assignment, 4);
+    bits.put (4, 3);  // 16 bits per sample
+    bits.put (0, 1);
+    writeUtf8 (bits, number);
+
+    if (count != standardBlockSize)
+        bits.put (count - 1, count <= 256 ? 8 : 16);
+
+    bits.put (crc8 (&bytes[0], bytes.size ()), 8);
+
+    for (unsigned short int channel = 0 ; channel != channelCount ; channel++)
+        writeSubframe (bits, sources[channel], count, sourceBits[channel], subframes[channel], residuals);
+
+    bits.alignToByte ();
+    bits.put (crc16 (&bytes[0], bytes.size ()), 16);
+}
+
+
+////////////////////////////////////////  Constructor / Destructor
+
+
+FlacWriter::FlacWriter (unsigned int threads, unsigned int frames) : sf::SoundFileWriter ()
+{
+    sampleRate = 44100;
+    channelCount = 2;
+    threadsCount = std::max (1U, threads);
+    blockSize = std::min (std::max (16U, frames), 65535U);  // The limits of the format
+
+    framesCount = 0;
+    totalFrames = 0;
+    minFrameSize = 0;
+    maxFrameSize = 0;
+    fileOffset = 0;
+
+    stopping = false;
+}
+
+FlacWriter::~FlacWriter ()
+{
+    close ();
+}
+
+
+////////////////////////////////////////  SFML writer interface
+
+
+bool FlacWriter::open (const std::string& newFileName, unsigned int rate, unsigned int channels)
+{
+    close ();
+
+    if (channels == 0 || channels > 8 || rate == 0 || rate >= (1 << 20))
+        return false;
+
+    fileName = newFileName;
+    file.open (fileName, std::ios::binary | std::ios::trunc);
+
+    if (!file)
+        return false;
+
+    sampleRate = rate;
+    channelCount = channels;
+
+    framesCount = 0;
+    totalFrames = 0;
+    minFrameSize = 0xFFFFFF;
+    maxFrameSize = 0;
+
+    pendingSamples.clear ();
+    pendingSamples.reserve (blockSize * channelCount);
+
+    writeStreamInfo ();  // Completed once the sizes are known
+
+    seekIndex.begin (sampleRate);
+    fileOffset = file.tellp ();
+
+    stopping = false;
+
+    if (threadsCount > 1)
+        for (unsigned int i = 0 ; i != threadsCount ; i++)
+            workers.emplace_back (&FlacWriter::work, this);
+
+    return true;
+}
+
+void FlacWriter::write (const sf::Int16* samples, sf::Uint64 samplesCount)
+{
+    while (samplesCount != 0)
+    {
+        std::size_t copied = std::min<sf::Uint64> (samplesCount, blockSize * channelCount - pendingSamples.size ());
+
+        pendingSamples.insert (pendingSamples.end (), samples, samples + copied);
+        samples += copied;
+        samplesCount -= copied;
+
+        if (pendingSamples.size () == blockSize * channelCount)
+            submit ();
+    }
+}
+
+
+////////////////////////////////////////  Encoding
+
+
+void FlacWriter::submit ()  // Hand the pending block to the pool, or encode it right now without pool
+{
+    std::shared_ptr<Frame> frame (new Frame);
+    frame->number = framesCount++;
+    frame->samples.swap (pendingSamples);
+    frame->encoded = false;
+
+    pendingSamples.reserve (blockSize * channelCount);
+    totalFrames += frame->samples.size () / channelCount;
+
+    if (workers.empty ())
+    {
+        encodeFrame (&frame->samples[0], frame->samples.size () / channelCount, channelCount, sampleRate, frame->number, frame->bytes);
+        frame->encoded = true;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock (mutex);
+
+        framesInFlight.push_back (frame);
+
+        if (!frame->encoded)
+            framesToEncode.push_back (frame);
+    }
+
+    workAvailable.notify_one ();
+
+    // Bounded memory : wait for the oldest frames when too many are queued
+    writeEncoded (framesInFlight.size () > 4 * threadsCount);
+}
+
+void FlacWriter::work ()
+{
+    std::unique_lock<std::mutex> lock (mutex);
+
+    while (true)
+    {
+        workAvailable.wait (lock, [this] () { return stopping || !framesToEncode.empty (); });
+
+        if (framesToEncode.empty ())
+            return;
+
+        std::shared_ptr<Frame> frame = framesToEncode.front ();
+        framesToEncode.pop_front ();
+
+        lock.unlock ();
+        encodeFrame (&frame->samples[0], frame->samples.size () / channelCount, channelCount, sampleRate, frame->number, frame->bytes);
+        lock.lock ();
+
+        frame->encoded = true;
+        frameEncoded.notify_all ();
+    }
+}
+
+void FlacWriter::writeEncoded (bool waitOldest)  // Write the frames already encoded at the head of the queue, in order
+{
+    std::unique_lock<std::mutex> lock (mutex);
+
+    if (waitOldest && !framesInFlight.empty ())
+        frameEncoded.wait (lock, [this] () { return framesInFlight.front ()->encoded; });
+
+    while (!framesInFlight.empty () && framesInFlight.front ()->encoded)
+    {
+        std::shared_ptr<Frame> frame = framesInFlight.front ();
+        framesInFlight.pop_front ();
+
+        lock.unlock ();
+
+        seekIndex.add (frame->number * blockSize, fileOffset);
+        fileOffset += frame->bytes.size ();
+
+        file.write (reinterpret_cast<const char*> (frame->bytes.data ()), frame->bytes.size ());
+
+        minFrameSize = std::min<unsigned int> (minFrameSize, frame->bytes.size ());
+        maxFrameSize = std::max<unsigned int> (maxFrameSize, frame->bytes.size ());
+
+        lock.lock ();
+    }
+}
+
+
+void FlacWriter::close ()
+{
+    if (!file.is_open ())
+        return;
+
+    if (!pendingSamples.empty ())
+        submit ();
+
+    while (true)
+    {
+        {
+            std::lock_guard<std::mutex> lock (mutex);
+
+            if (framesInFlight.empty ())
+                break;
+        }
+
+        writeEncoded (true);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock (mutex);
+        stopping = true;
+    }
+
+    workAvailable.notify_all ();
+
+    for (std::thread& worker : workers)
+        worker.join ();
+
+    workers.clear ();
+
+
+    file.seekp (0);
+    writeStreamInfo ();
+
+    file.close ();
+
+    seekIndex.save (QString::fromLocal8Bit (fileName.c_str ()));
+}
+
+void FlacWriter::writeStreamInfo ()  // Signature and the only metadata block, rewritten at the end with the final values
+{
+    std::vector<unsigned char> bytes ({'f', 'L', 'a', 'C'});
+    BitWriter bits (bytes);
+
+    bits.put (1, 1);  // Last metadata block
+    bits.put (0, 7);  // STREAMINFO
+    bits.put (34, 24);
+
+    bits.put (blockSize, 16);
+    bits.put (blockSize, 16);
+    bits.put (maxFrameSize != 0 ? minFrameSize : 0, 24);
+    bits.put (maxFrameSize, 24);
+    bits.put (sampleRate, 20);
+    bits.put (channelCount - 1, 3);
+    bits.put (bitsPerSample - 1, 5);
+    bits.put (totalFrames >> 32, 4);
+    bits.put (totalFrames & 0xFFFFFFFF, 32);
+
+    for (unsigned short int i = 0 ; i != 4 ; i++)  // MD5 of the audio left unset, allowed by the format
+        bits.put (0, 32);
+
+    file.write (reinterpret_cast<const char*> (bytes.data ()), bytes.size ());
+}
@@ -0,0 +1,78 @@
+#ifndef FLACWRITER_H
+#define FLACWRITER_H
+
+
+#include <SFML/Audio.hpp>
+
+#include <fstream>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "SeekIndex.h"
+
+
+// FLAC encoder spreading independent frames over a pool of threads, frames are written back in order
+// Each frame only depends on its own samples, so the file is the same whatever the threads count
+// The offset of each frame is noted as it is written, and saved as the seek index of the file when it is closed
+
+class FlacWriter : public sf::SoundFileWriter
+{
+    public:
+        explicit FlacWriter (unsigned int = 1, unsigned int = 4096);  // Threads count and frames per block
+        virtual ~FlacWriter ();
+
+        virtual bool open (const std::string&, unsigned int, unsigned int) override;
+        virtual void write (const sf::Int16*, sf::Uint64) override;
+
+
+    private:
+        struct Frame
+        {
+            unsigned long long int number;
+            std::vector<sf::Int16> samples;
+            std::vector<unsigned char> bytes;
+            bool encoded;
+        };
+
+
+        void submit ();
+        void work ();
+        void writeEncoded (bool);
+
+        void close ();
+        void writeStreamInfo ();
+
+
+        std::ofstream file;
+        std::string fileName;
+
+        SeekIndexBuilder seekIndex;
+        unsigned long long int fileOffset;  // Where the next frame goes
+
+        unsigned int sampleRate;
+        unsigned int channelCount;
+        unsigned int threadsCount;
+        unsigned int blockSize;
+
+        std::vector<sf::Int16> pendingSamples;
+        unsigned long long int framesCount;
+        unsigned long long int totalFrames;  // Audio frames, as counted in the stream info
+
+        unsigned int minFrameSize;
+        unsigned int maxFrameSize;
+
+        std::deque<std::shared_ptr<Frame>> framesInFlight;  // In file order, the first ones may still be encoding
+        std::deque<std::shared_ptr<Frame>> framesToEncode;
+
+        std::mutex mutex;
+        std::condition_variable workAvailable;
+        std::condition_variable frameEncoded;
+        std::vector<std::thread> workers;
+        bool stopping;
+};
+
+
+#endif // FLACWRITER_H
@@ -0,0 +1,352 @@
+#include <cmath>
+
+#include "GainKernel.h"
+
+#if defined (__x86_64__) || defined (_M_X64) || defined (__i386__) || defined (_M_IX86)
+    #define GAINKERNEL_X86
+    #include <immintrin.h>
+#endif
+
+
+// Per channel running sums shared by all code paths
+
+struct Accumulator
+{
+    float peak[AudioLevels::maxChannels];
+    double squaresSum[AudioLevels::maxChannels];
+    unsigned int clippedSamples[AudioLevels::maxChannels];
+};
+
+
+////////////////////////////////////////  Scalar path, reference for the clamp semantics
+
+
+static void processScalar (const sf::Int16* samples, sf::Int16* output, std::size_t first, std::size_t samplesCount, float coefficient, unsigned short int channelCount, Accumulator& accumulator)
+{
+    int amplifiedSample;
+    unsigned short int channel = first % channelCount;
+
+    for (std::size_t i = first ; i != samplesCount ; i++)
+    {
+        if (output)
+        {
+            amplifiedSample = samples[i] * coefficient;
+
+            if (amplifiedSample > 32767)
+                amplifiedSample = 32767;
+
+            else if (amplifiedSample < -32768)
+                amplifiedSample = -32768;
+
+            output[i] = amplifiedSample;
+        }
+        else
+            amplifiedSample = samples[i];
+
+
+        accumulator.peak[channel] = std::max (accumulator.peak[channel], float (std::abs (amplifiedSample)));
+        accumulator.squaresSum[channel] += double (amplifiedSample) * amplifiedSample;
+
+        if (std::abs (amplifiedSample) >= 32767)
+            accumulator.clippedSamples[channel]++;
+
+        if (++channel == channelCount)
+            channel = 0;
+    }
+}
+
+
+// Unclamped gain for the limiter, with the magnitude of each sample for its envelope detection
+
+static void amplifyScalar (const sf::Int16* samples, float* output, float* magnitudes, std::size_t first, std::size_t samplesCount, float coefficient)
+{
+    for (std::size_t i = first ; i != samplesCount ; i++)
+    {
+        output[i] = samples[i] * coefficient;
+        magnitudes[i] = std::abs (output[i]);
+    }
+}
+
+
+#ifdef GAINKERNEL_X86
+
+// Lane i of the vector accumulators always holds channel i % channelCount, this is why the vector paths need a channel count dividing their width
+
+static void reduceLanes (const float peak[], const float squaresSum[], const int clippedSamples[], unsigned short int lanes, unsigned short int channelCount, Accumulator& accumulator)
+{
+    for (unsigned short int i = 0 ; i != lanes ; i++)
+    {
+        accumulator.peak[i % channelCount] = std::max (accumulator.peak[i % channelCount], peak[i]);
+        accumulator.squaresSum[i % channelCount] += squaresSum[i];
+        accumulator.clippedSamples[i % channelCount] += clippedSamples[i];
+    }
+}
+
+static const std::size_t flushInterval = 256;  // Iterations between two flushes of the single precision sums, keeps them accurate
+
+
+////////////////////////////////////////  SSE2 path, 8 samples per iteration
+
+
+#if defined (__GNUC__) || defined (__clang__)
+__attribute__ ((target ("sse2")))
+#endif
+static void processSSE2 (const sf::Int16* samples, sf::Int16* output, std::size_t samplesCount, float coefficient, unsigned short int channelCount, Accumulator& accumulator)
+{
+    const __m128 factor = _mm_set1_ps (coefficient);
+    const __m128 absMask = _mm_castsi128_ps (_mm_set1_epi32 (0x7FFFFFFF));
+    const __m128 fullScale = _mm_set1_ps (32767);
+
+    __m128 peak = _mm_setzero_ps ();
+    __m128i clippedSamples = _mm_setzero_si128 ();
+
+    float peakLanes[4], squaresLanes[4];
+    int clippedLanes[4];
+
+    std::size_t i = 0;
+
+    while (i + 8 <= samplesCount)
+    {
+        __m128 squaresSum = _mm_setzero_ps ();
+
+        for (std::size_t iteration = 0 ; iteration != flushInterval && i + 8 <= samplesCount ; iteration++, i += 8)
+        {
+            __m128i result = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (samples + i));
+
+            // Sign extend to 32 bits, multiply in single precision and truncate like the scalar conversion
+            __m128i low = _mm_srai_epi32 (_mm_unpacklo_epi16 (result, result), 16);
+            __m128i high = _mm_srai_epi32 (_mm_unpackhi_epi16 (result, result), 16);
+
+            if (output)
+            {
+                low = _mm_cvttps_epi32 (_mm_mul_ps (_mm_cvtepi32_ps (low), factor));
+                high = _mm_cvttps_epi32 (_mm_mul_ps (_mm_cvtepi32_ps (high), factor));
+
+                result = _mm_packs_epi32 (low, high);  // Saturates to [-32768, 32767]
+                _mm_storeu_si128 (reinterpret_cast<__m128i*> (output + i), result);
+
+                low = _mm_srai_epi32 (_mm_unpacklo_epi16 (result, result), 16);
+                high = _mm_srai_epi32 (_mm_unpackhi_epi16 (result, result), 16);
+            }
+
+            __m128 lowValues = _mm_cvtepi32_ps (low);
+            __m128 highValues = _mm_cvtepi32_ps (high);
+            __m128 lowAbs = _mm_and_ps (lowValues, absMask);
+            __m128 highAbs = _mm_and_ps (highValues, absMask);
+
+            peak = _mm_max_ps (peak, _mm_max_ps (lowAbs, highAbs));
+            squaresSum = _mm_add_ps (squaresSum, _mm_add_ps (_mm_mul_ps (lowValues, lowValues), _mm_mul_ps (highValues, highValues)));
+
+            clippedSamples = _mm_sub_epi32 (clippedSamples, _mm_castps_si128 (_mm_cmpge_ps (lowAbs, fullScale)));
+            clippedSamples = _mm_sub_epi32 (clippedSamples, _mm_castps_si128 (_mm_cmpge_ps (highAbs, fullScale)));
+        }
+
+        _mm_storeu_ps (squaresLanes, squaresSum);
+
+        for (unsigned short int lane = 0 ; lane != 4 ; lane++)
+            accumulator.squaresSum[lane % channelCount] += squaresLanes[lane];
+    }
+
+    _mm_storeu_ps (peakLanes, peak);
+    _mm_storeu_si128 (reinterpret_cast<__m128i*> (clippedLanes), clippedSamples);
+
+    std::fill (squaresLanes, squaresLanes + 4, 0.0f);
+    reduceLanes (peakLanes, squaresLanes, clippedLanes, 4, channelCount, accumulator);
+
+    processScalar (samples, output, i, samplesCount, coefficient, channelCount, accumulator);
+}
+
+#if defined (__GNUC__) || defined (__clang__)
+__attribute__ ((target ("sse2")))
+#endif
+static void amplifySSE2 (const sf::Int16* samples, float* output, float* magnitudes, std::size_t samplesCount, float coefficient)
+{
+    const __m128 factor = _mm_set1_ps (coefficient);
+    const __m128 absMask = _mm_castsi128_ps (_mm_set1_epi32 (0x7FFFFFFF));
+
+    std::size_t i = 0;
+
+    for ( ; i + 8 <= samplesCount ; i += 8)
+    {
+        __m128i values = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (samples + i));
+
+        __m128 low = _mm_mul_ps (_mm_cvtepi32_ps (_mm_srai_epi32 (_mm_unpacklo_epi16 (values, values), 16)), factor);
+        __m128 high = _mm_mul_ps (_mm_cvtepi32_ps (_mm_srai_epi32 (_mm_unpackhi_epi16 (values, values), 16)), factor);
+
+        _mm_storeu_ps (output + i, low);
+        _mm_storeu_ps (output + i + 4, high);
+        _mm_storeu_ps (magnitudes + i, _mm_and_ps (low, absMask));
+        _mm_storeu_ps (magnitudes + i + 4, _mm_and_ps (high, absMask));
+    }
+
+    amplifyScalar (samples, output, magnitudes, i, samplesCount, coefficient);
+}
+
+
+////////////////////////////////////////  AVX2 path, 16 samples per iteration
+
+
+#if defined (__GNUC__) || defined (__clang__)
+__attribute__ ((target ("avx2")))
+#endif
+static void processAVX2 (const sf::Int16* samples, sf::Int16* output, std::size_t samplesCount, float coefficient, unsigned short int channelCount, Accumulator& accumulator)
+{
+    const __m256 factor = _mm256_set1_ps (coefficient);
+    const __m256 absMask = _mm256_castsi256_ps (_mm256_set1_epi32 (0x7FFFFFFF));
+    const __m256 fullScale = _mm256_set1_ps (32767);
+
+    __m256 peak = _mm256_setzero_ps ();
+    __m256i clippedSamples = _mm256_setzero_si256 ();
+
+    float peakLanes[8], squaresLanes[8];
+    int clippedLanes[8];
+
+    std::size_t i = 0;
+
+    while (i + 16 <= samplesCount)
+    {
+        __m256 squaresSum = _mm256_setzero_ps ();
+
+        for (std::size_t iteration = 0 ; iteration != flushInterval && i + 16 <= samplesCount ; iteration++, i += 16)
+        {
+            __m256i low = _mm256_cvtepi16_epi32 (_mm_loadu_si128 (reinterpret_cast<const __m128i*> (samples + i)));
+            __m256i high = _mm256_cvtepi16_epi32 (_mm_loadu_si128 (reinterpret_cast<const __m128i*> (samples + i + 8)));
+
+            if (output)
+            {
+                low = _mm256_cvttps_epi32 (_mm256_mul_ps (_mm256_cvtepi32_ps (low), factor));
+                high = _mm256_cvttps_epi32 (_mm256_mul_ps (_mm256_cvtepi32_ps (high), factor));
+
+                // Packing works per 128 bits lane, put the quad words back in order
+                __m256i result = _mm256_permute4x64_epi64 (_mm256_packs_epi32 (low, high), 0xD8);
+                _mm256_storeu_si256 (reinterpret_cast<__m256i*> (output + i), result);
+
+                low = _mm256_cvtepi16_epi32 (_mm256_castsi256_si128 (result));
+                high = _mm256_cvtepi16_epi32 (_mm256_extracti128_si256 (result, 1));
+            }
+
+            __m256 lowValues = _mm256_cvtepi32_ps (low);
+            __m256 highValues = _mm256_cvtepi32_ps (high);
+            __m256 lowAbs = _mm256_and_ps (lowValues, absMask);
+            __m256 highAbs = _mm256_and_ps (highValues, absMask);
+
+            peak = _mm256_max_ps (peak, _mm256_max_ps (lowAbs, highAbs));
+            squaresSum = _mm256_add_ps (squaresSum, _mm256_add_ps (_mm256_mul_ps (lowValues, lowValues), _mm256_mul_ps (highValues, highValues)));
+
+            clippedSamples = _mm256_sub_epi32 (clippedSamples, _mm256_castps_si256 (_mm256_cmp_ps (lowAbs, fullScale, _CMP_GE_OQ)));
+            clippedSamples = _mm256_sub_epi32 (clippedSamples, _mm256_castps_si256 (_mm256_cmp_ps (highAbs, fullScale, _CMP_GE_OQ)));
+        }
+
+        _mm256_storeu_ps (squaresLanes, squaresSum);
+
+        for (unsigned short int lane = 0 ; lane != 8 ; lane++)
+            accumulator.squaresSum[lane % channelCount] += squaresLanes[lane];
+    }
+
+    _mm256_storeu_ps (peakLanes, peak);
+    _mm256_storeu_si256 (reinterpret_cast<__m256i*> (clippedLanes), clippedSamples);
+
+    std::fill (squaresLanes, squaresLanes + 8, 0.0f);
+    reduceLanes (peakLanes, squaresLanes, clippedLanes, 8, channelCount, accumulator);
+
+    processScalar (samples, output, i, samplesCount, coefficient, channelCount, accumulator);
+}
+
+#if defined (__GNUC__) || defined (__clang__)
+__attribute__ ((target ("avx2")))
+#endif
+static void amplifyAVX2 (const sf::Int16* samples, float* output, float* magnitudes, std::size_t samplesCount, float coefficient)
+{
+    const __m256 factor = _mm256_set1_ps (coefficient);
+    const __m256 absMask = _mm256_castsi256_ps (_mm256_set1_epi32 (0x7FFFFFFF));
+
+    std::size_t i = 0;
+
+    for ( ; i + 8 <= samplesCount ; i += 8)
+    {
+        __m256 values = _mm256_mul_ps (_mm256_cvtepi32_ps (_mm256_cvtepi16_epi32 (_mm_loadu_si128 (reinterpret_cast<const __m128i*> (samples + i)))), factor);
+
+        _mm256_storeu_ps (output + i, values);
+        _mm256_storeu_ps (magnitudes + i, _mm256_and_ps (values, absMask));
+    }
+
+    amplifyScalar (samples, output, magnitudes, i, samplesCount, coefficient);
+}
+
+#endif // GAINKERNEL_X86
+
+
+////////////////////////////////////////  Runtime dispatch
+
+
+typedef void (*VectorFunction) (const sf::Int16*, sf::Int16*, std::size_t, float, unsigned short int, Accumulator&);
+typedef void (*AmplifyFunction) (const sf::Int16*, float*, float*, std::size_t, float);
+
+struct GainImplementation
+{
+    VectorFunction function;
+    AmplifyFunction amplify;
+    unsigned short int lanes;
+    const char* name;
+};
+
+static GainImplementation selectImplementation ()
+{
+    #ifdef GAINKERNEL_X86
+        #if defined (__GNUC__) || defined (__clang__)
+            __builtin_cpu_init ();
+
+            if (__builtin_cpu_supports ("avx2"))
+                return {processAVX2, amplifyAVX2, 8, "AVX2"};
+
+            if (__builtin_cpu_supports ("sse2"))
+                return {processSSE2, amplifySSE2, 4, "SSE2"};
+        #else
+            return {processSSE2, amplifySSE2, 4, "SSE2"};
+        #endif
+    #endif
+
+    return {nullptr, nullptr, 0, "scalar"};
+}
+
+static const GainImplementation selectedImplementation = selectImplementation ();
+
+
+void GainKernel::process (const sf::Int16* samples, sf::Int16* output, std::size_t samplesCount, float coefficient, unsigned short int channelCount, AudioLevels& levels)
+{
+    channelCount = std::max<unsigned short int> (1, std::min<unsigned short int> (channelCount, AudioLevels::maxChannels));
+
+    Accumulator accumulator = {};
+
+    if (selectedImplementation.function && selectedImplementation.lanes % channelCount == 0)
+        selectedImplementation.function (samples, output, samplesCount, coefficient, channelCount, accumulator);
+
+    else
+        processScalar (samples, output, 0, samplesCount, coefficient, channelCount, accumulator);
+
+
+    std::size_t framesCount = std::max<std::size_t> (1, samplesCount / channelCount);
+
+    levels.channelCount = channelCount;
+
+    for (unsigned short int i = 0 ; i != channelCount ; i++)
+    {
+        levels.channels[i].peak = accumulator.peak[i] / 32768.0f;
+        levels.channels[i].rms = std::sqrt (accumulator.squaresSum[i] / framesCount) / 32768.0;
+        levels.channels[i].clippedSamples = accumulator.clippedSamples[i];
+    }
+}
+
+void GainKernel::amplify (const sf::Int16* samples, float* output, float* magnitudes, std::size_t samplesCount, float coefficient)
+{
+    if (selectedImplementation.amplify)
+        selectedImplementation.amplify (samples, output, magnitudes, samplesCount, coefficient);
+
+    else
+        amplifyScalar (samples, output, magnitudes, 0, samplesCount, coefficient);
+}
+
+const char* GainKernel::implementation ()
+{
+    return selectedImplementation.name;
+}
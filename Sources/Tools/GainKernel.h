@@ -0,0 +1,24 @@
+#ifndef GAINKERNEL_H
+#define GAINKERNEL_H
+
+
+#include <SFML/Audio.hpp>
+
+#include "AudioLevels.h"
+
+
+// Saturating gain applied to 16 bits samples, fused with per channel metering and vectorized when the CPU allows it
+
+namespace GainKernel
+{
+    // Without output buffer, samples are only measured
+    void process (const sf::Int16*, sf::Int16*, std::size_t, float, unsigned short int, AudioLevels&);
+
+    // Gain without clamping into a float buffer, with the absolute value of each sample
+    void amplify (const sf::Int16*, float*, float*, std::size_t, float);
+
+    const char* implementation ();  // Name of the code path selected for this CPU
+}
+
+
+#endif // GAINKERNEL_H
@@ -0,0 +1,195 @@
+#include <cmath>
+#include <algorithm>
+
+#include "Limiter.h"
+#include "GainKernel.h"
+
+
+static const float ceiling = 32767 * 0.966f;  // -0.3 dBFS
+static const unsigned int lookAheadTime = 5;  // Milliseconds
+static const double releaseTime = 0.08;  // Seconds
+static const std::size_t blockFrames = 1024;  // Chunks are processed by blocks of this size, whatever SFML delivers
+
+static const float automaticGainTarget = -18;  // RMS in dBFS
+static const float automaticGainRange = 20;  // Maximum boost or cut in dB
+static const float automaticGainFloor = -55;  // Quieter inputs are considered as silence and keep the current gain
+static const double automaticGainTime = 3;  // Seconds to correct most of the error
+static const float automaticGainSpeed = 6;  // Maximum change in dB per second
+
+
+Limiter::Limiter ()
+{
+    channelCount = 1;
+    lookAhead = 1;
+
+    _automaticGain = false;
+    automaticGainDecibels = 0;
+
+    prepare (44100, 1);
+}
+
+
+////////////////////////////////////////  Settings
+
+
+void Limiter::setAutomaticGain (bool enabled)
+{
+    _automaticGain = enabled;
+}
+
+void Limiter::prepare (unsigned int sampleRate, unsigned short int channels)  // Allocate everything for this format, not thread safe
+{
+    channelCount = std::max<unsigned short int> (1, channels);
+    lookAhead = std::max<std::size_t> (1, std::size_t (sampleRate) * lookAheadTime / 1000);
+
+    silence.assign (blockFrames * channelCount, 0);
+    amplified.assign (blockFrames * channelCount, 0);
+    magnitudes.assign (blockFrames * channelCount, 0);
+    delayLine.assign (lookAhead * channelCount, 0);
+
+    minimumValues.assign (lookAhead + 1, 0);
+    minimumFrames.assign (lookAhead + 1, 0);
+    averageWindow.assign (lookAhead, 0);
+
+    releaseCoefficient = 1 - std::exp (-1 / (releaseTime * sampleRate));
+
+    reset ();
+}
+
+void Limiter::reset ()
+{
+    std::fill (delayLine.begin (), delayLine.end (), 0.0f);
+    std::fill (averageWindow.begin (), averageWindow.end (), 1.0f);
+
+    delayPosition = 0;
+    minimumFirst = 0;
+    minimumCount = 0;
+    frameIndex = 0;
+    averagePosition = 0;
+    averageSum = averageWindow.size ();
+
+    heldGain = 1;
+    lowestGain = 1;
+    automaticGainDecibels = 0;
+}
+
+
+////////////////////////////////////////  Processing
+
+
+void Limiter::process (const sf::Int16* samples, sf::Int16* output, std::size_t samplesCount, float volume)  // Output has the same length, delayed by the look-ahead
+{
+    float coefficient = volume * std::pow (10.0f, automaticGainDecibels / 20);
+
+    lowestGain = 1;
+
+    for (std::size_t first = 0 ; first < samplesCount ; first += blockFrames * channelCount)
+    {
+        std::size_t count = std::min (blockFrames * channelCount, samplesCount - first);
+
+        processBlock (samples + first, output + first, count - count % channelCount, coefficient);
+    }
+}
+
+std::size_t Limiter::flush (sf::Int16* output)  // Output the look-ahead still in the delay line and start again empty, returns the samples count
+{
+    for (std::size_t first = 0 ; first < lookAhead ; first += blockFrames)
+        processBlock (&silence[0], output + first * channelCount, std::min (blockFrames, lookAhead - first) * channelCount, 1);
+
+    std::size_t samplesCount = lookAhead * channelCount;
+
+    reset ();
+
+    return samplesCount;
+}
+
+void Limiter::processBlock (const sf::Int16* samples, sf::Int16* output, std::size_t samplesCount, float coefficient)
+{
+    GainKernel::amplify (samples, &amplified[0], &magnitudes[0], samplesCount, coefficient);
+
+    std::size_t framesCount = samplesCount / channelCount;
+
+    for (std::size_t frame = 0 ; frame != framesCount ; frame++)
+    {
+        const float* frameMagnitudes = &magnitudes[frame * channelCount];
+        float peak = *std::max_element (frameMagnitudes, frameMagnitudes + channelCount);
+
+        // The release only slows down gain increases, the gain stays below the needed one
+        float neededGain = windowMinimum (peak > ceiling ? ceiling / peak : 1);
+        heldGain = std::min (neededGain, heldGain + (1 - heldGain) * releaseCoefficient);
+
+        averageSum += heldGain - averageWindow[averagePosition];
+        averageWindow[averagePosition] = heldGain;
+        averagePosition = averagePosition + 1 == lookAhead ? 0 : averagePosition + 1;
+
+        float gain = std::min (1.0, averageSum / lookAhead);
+        lowestGain = std::min (lowestGain, gain);
+
+
+        float* delayed = &delayLine[delayPosition * channelCount];
+
+        for (unsigned short int channel = 0 ; channel != channelCount ; channel++)
+        {
+            float limitedSample = delayed[channel] * gain;
+
+            // Rounding errors of the running sum may still leave a tiny overshoot
+            output[frame * channelCount + channel] = std::max (-32768.0f, std::min (32767.0f, limitedSample));
+            delayed[channel] = amplified[frame * channelCount + channel];
+        }
+
+        delayPosition = delayPosition + 1 == lookAhead ? 0 : delayPosition + 1;
+        frameIndex++;
+    }
+}
+
+float Limiter::windowMinimum (float neededGain)  // Push the gain needed by the newest frame, returns the minimum of the last look-ahead + 1 frames
+{
+    std::size_t capacity = minimumValues.size ();
+
+    if (minimumCount != 0 && frameIndex - minimumFrames[minimumFirst] >= capacity)  // Left the window
+    {
+        minimumFirst = (minimumFirst + 1) % capacity;
+        minimumCount--;
+    }
+
+    while (minimumCount != 0 && minimumValues[(minimumFirst + minimumCount - 1) % capacity] >= neededGain)
+        minimumCount--;
+
+    minimumValues[(minimumFirst + minimumCount) % capacity] = neededGain;
+    minimumFrames[(minimumFirst + minimumCount) % capacity] = frameIndex;
+    minimumCount++;
+
+    return minimumValues[minimumFirst];
+}
+
+
+void Limiter::updateAutomaticGain (float level, double chunkDuration)  // Feed the RMS level of the processed chunk, the new gain is used by the next one
+{
+    if (!_automaticGain || level <= 0)
+        return;
+
+    float levelDecibels = 20 * std::log10 (level);
+
+    if (levelDecibels - automaticGainDecibels < automaticGainFloor)
+        return;
+
+    float change = (automaticGainTarget - levelDecibels) * std::min (1.0, chunkDuration / automaticGainTime);
+    float maxChange = automaticGainSpeed * chunkDuration;
+
+    automaticGainDecibels += std::max (-maxChange, std::min (maxChange, change));
+    automaticGainDecibels = std::max (-automaticGainRange, std::min (automaticGainRange, automaticGainDecibels));
+}
+
+
+////////////////////////////////////////  Others
+
+
+float Limiter::gainReduction () const  // Strongest reduction applied to the last chunk by the limiter, in dB
+{
+    return 20 * std::log10 (lowestGain);
+}
+
+float Limiter::automaticGain () const  // Current gain of the automatic stage, in dB
+{
+    return automaticGainDecibels;
+}
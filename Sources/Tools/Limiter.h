@@ -0,0 +1,68 @@
+#ifndef LIMITER_H
+#define LIMITER_H
+
+
+#include <SFML/Audio.hpp>
+
+#include <vector>
+
+
+// Look-ahead brickwall limiter used instead of clipping, with an optional slow automatic gain in front of it
+// The output is delayed by the look-ahead time, every buffer is allocated by prepare so processing never allocates
+
+class Limiter
+{
+    public:
+        Limiter ();
+
+
+        void setAutomaticGain (bool);
+
+        void prepare (unsigned int, unsigned short int);
+        void reset ();
+
+        void process (const sf::Int16*, sf::Int16*, std::size_t, float);
+        std::size_t flush (sf::Int16*);
+        void updateAutomaticGain (float, double);
+
+        float gainReduction () const;
+        float automaticGain () const;
+
+
+    private:
+        void processBlock (const sf::Int16*, sf::Int16*, std::size_t, float);
+        float windowMinimum (float);
+
+
+        unsigned short int channelCount;
+        std::size_t lookAhead;  // In frames
+
+        std::vector<sf::Int16> silence;
+        std::vector<float> amplified;
+        std::vector<float> magnitudes;
+
+        std::vector<float> delayLine;
+        std::size_t delayPosition;
+
+        // Minimum of the needed gains over the look-ahead window, kept as a monotonic queue
+        std::vector<float> minimumValues;
+        std::vector<unsigned long long int> minimumFrames;
+        std::size_t minimumFirst;
+        std::size_t minimumCount;
+        unsigned long long int frameIndex;
+
+        // Moving average smoothing the gain so it reaches its target right when the peak leaves the delay line
+        std::vector<float> averageWindow;
+        std::size_t averagePosition;
+        double averageSum;
+
+        float heldGain;
+        float releaseCoefficient;
+        float lowestGain;
+
+        bool _automaticGain;
+        float automaticGainDecibels;
+};
+
+
+#endif // LIMITER_H
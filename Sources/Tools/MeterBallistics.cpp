@@ -0,0 +1,66 @@
+#include <cmath>
+#include <algorithm>
+
+#include "MeterBallistics.h"
+
+
+static const float floorLevel = -120;  // dBFS shown for digital silence
+static const float peakFallRate = 20 / 1.7;  // dB per second
+static const float heldPeakFallRate = 30;
+static const double holdTime = 2;
+static const double rmsIntegrationTime = 0.3;
+
+
+static float levelToDecibels (double level)
+{
+    return level > 0 ? std::max (floorLevel, float (20 * std::log10 (level))) : floorLevel;
+}
+
+
+MeterBallistics::MeterBallistics ()
+{
+    reset ();
+}
+
+
+void MeterBallistics::reset ()
+{
+    for (unsigned short int i = 0 ; i != AudioLevels::maxChannels ; i++)
+    {
+        peak[i] = floorLevel;
+        heldPeak[i] = floorLevel;
+        holdLeft[i] = 0;
+        meanSquare[i] = 0;
+    }
+}
+
+void MeterBallistics::process (AudioLevels& levels, double chunkDuration)
+{
+    double rmsCoefficient = 1 - std::exp (-chunkDuration / rmsIntegrationTime);
+
+    for (unsigned short int i = 0 ; i != levels.channelCount ; i++)
+    {
+        ChannelLevels& channel = levels.channels[i];
+        float chunkPeak = levelToDecibels (channel.peak);
+
+        peak[i] = std::max (chunkPeak, peak[i] - float (peakFallRate * chunkDuration));
+
+        if (chunkPeak >= heldPeak[i])
+        {
+            heldPeak[i] = chunkPeak;
+            holdLeft[i] = holdTime;
+        }
+        else if (holdLeft[i] > 0)
+            holdLeft[i] -= chunkDuration;
+
+        else
+            heldPeak[i] = std::max (peak[i], heldPeak[i] - float (heldPeakFallRate * chunkDuration));
+
+        meanSquare[i] += (double (channel.rms) * channel.rms - meanSquare[i]) * rmsCoefficient;
+
+
+        channel.meterPeak = peak[i];
+        channel.meterRms = levelToDecibels (std::sqrt (meanSquare[i]));
+        channel.heldPeak = heldPeak[i];
+    }
+}
@@ -0,0 +1,29 @@
+#ifndef METERBALLISTICS_H
+#define METERBALLISTICS_H
+
+
+#include "AudioLevels.h"
+
+
+// Meter ballistics applied chunk by chunk on the capture thread, so the display only has to draw the latest values
+// Peak : instant attack and a fall of 20 dB in 1.7 s (IEC 60268-18), held for 2 s then falling faster
+// RMS : exponential integration over 300 ms, like a VU meter
+
+class MeterBallistics
+{
+    public:
+        MeterBallistics ();
+
+        void reset ();
+        void process (AudioLevels&, double);  // Chunk levels and their duration in seconds, fills the meter values
+
+
+    private:
+        float peak[AudioLevels::maxChannels];
+        float heldPeak[AudioLevels::maxChannels];
+        double holdLeft[AudioLevels::maxChannels];
+        double meanSquare[AudioLevels::maxChannels];
+};
+
+
+#endif // METERBALLISTICS_H
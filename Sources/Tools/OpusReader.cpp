@@ -0,0 +1,116 @@
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+
+#include "OpusReader.h"
+
+
+static const unsigned int maxPacketFrames = 5760;  // 120 ms at 48 kHz
+
+
+////////////////////////////////////////  Stream callbacks
+
+
+static int readCallback (void* data, unsigned char* buffer, int bytesCount)
+{
+    sf::Int64 readBytes = static_cast<sf::InputStream*> (data)->read (buffer, bytesCount);
+
+    return readBytes >= 0 ? int (readBytes) : -1;
+}
+
+static int seekCallback (void* data, opus_int64 offset, int whence)
+{
+    sf::InputStream* stream = static_cast<sf::InputStream*> (data);
+
+    if (whence == SEEK_CUR)
+        offset += stream->tell ();
+
+    else if (whence == SEEK_END)
+        offset += stream->getSize ();
+
+    return stream->seek (offset) == offset ? 0 : -1;
+}
+
+static opus_int64 tellCallback (void* data)
+{
+    return static_cast<sf::InputStream*> (data)->tell ();
+}
+
+
+////////////////////////////////////////  SFML reader interface
+
+
+OpusReader::OpusReader ()
+{
+    opus = nullptr;
+    channelCount = 1;
+}
+
+OpusReader::~OpusReader ()
+{
+    close ();
+}
+
+
+bool OpusReader::check (sf::InputStream& stream)  // The identification header starts the first page
+{
+    char header[36];
+
+    return stream.read (header, sizeof (header)) == sizeof (header) && std::memcmp (header, "OggS", 4) == 0 && std::memcmp (header + 28, "OpusHead", 8) == 0;
+}
+
+bool OpusReader::open (sf::InputStream& stream, Info& info)
+{
+    close ();
+
+    OpusFileCallbacks callbacks = {&readCallback, &seekCallback, &tellCallback, nullptr};
+
+    opus = op_open_callbacks (&stream, &callbacks, nullptr, 0, nullptr);
+
+    if (opus == nullptr || op_channel_count (opus, -1) <= 0)
+    {
+        close ();
+        return false;
+    }
+
+    channelCount = op_channel_count (opus, -1);
+
+    info.channelCount = channelCount;
+    info.sampleRate = 48000;
+    info.sampleCount = sf::Uint64 (std::max<ogg_int64_t> (0, op_pcm_total (opus, -1))) * channelCount;
+
+    return true;
+}
+
+void OpusReader::close ()
+{
+    if (opus != nullptr)
+        op_free (opus);
+
+    opus = nullptr;
+}
+
+
+void OpusReader::seek (sf::Uint64 sampleOffset)
+{
+    op_pcm_seek (opus, sampleOffset / channelCount);  // Exact to the sample, libopusfile decodes the pre-roll itself
+}
+
+sf::Uint64 OpusReader::read (sf::Int16* samples, sf::Uint64 maxCount)
+{
+    sf::Uint64 count = 0;
+
+    while (maxCount - count >= channelCount)
+    {
+        int samplesToRead = int (std::min<sf::Uint64> ((maxCount - count) / channelCount, maxPacketFrames) * channelCount);
+        int readFrames = op_read (opus, samples + count, samplesToRead, nullptr);
+
+        if (readFrames > 0)
+            count += sf::Uint64 (readFrames) * channelCount;
+
+        else if (readFrames != OP_HOLE)  // End of the file or error, a hole is only a gap in the data
+            break;
+    }
+
+    return count;
+}
@@ -0,0 +1,35 @@
+#ifndef OPUSREADER_H
+#define OPUSREADER_H
+
+
+#include <SFML/Audio.hpp>
+
+#include <opus/opusfile.h>
+
+
+// Ogg/Opus decoder through libopusfile, which SFML lacks : registered to its factory, so the recordings written by
+// OpusWriter are played, measured and converted as the other formats. Always decoded at 48 kHz, as Opus encodes
+
+class OpusReader : public sf::SoundFileReader
+{
+    public:
+        OpusReader ();
+        virtual ~OpusReader ();
+
+        static bool check (sf::InputStream&);
+
+        virtual bool open (sf::InputStream&, Info&) override;
+        virtual void seek (sf::Uint64) override;
+        virtual sf::Uint64 read (sf::Int16*, sf::Uint64) override;
+
+
+    private:
+        void close ();
+
+
+        OggOpusFile* opus;
+        unsigned int channelCount;
+};
+
+
+#endif // OPUSREADER_H
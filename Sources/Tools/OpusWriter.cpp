@@ -0,0 +1,246 @@
+#include <cstring>
+#include <random>
+#include <algorithm>
+
+#include "OpusWriter.h"
+
+
+static const unsigned int granuleRate = 48000;
+static const unsigned int encoderRates[] = {8000, 12000, 16000, 24000, 48000};
+static const unsigned int maxPacketSize = 4000;  // Recommended by libopus for any frame size
+
+
+static void putLittleEndian (std::vector<unsigned char>& bytes, unsigned long int value, unsigned short int size)
+{
+    for (unsigned short int i = 0 ; i != size ; i++)
+        bytes.push_back ((unsigned char) (value >> (8 * i)));
+}
+
+
+////////////////////////////////////////  Constructor / Destructor
+
+
+OpusWriter::OpusWriter (unsigned int bitrate, unsigned int complexity) : sf::SoundFileWriter ()
+{
+    encoder = nullptr;
+
+    this->bitrate = bitrate;
+    this->complexity = std::min (complexity, 10U);
+
+    inputRate = granuleRate;
+    encoderRate = granuleRate;
+    channelCount = 2;
+    frameSize = granuleRate / 50;
+
+    lookAhead = 0;
+    preSkip = 0;
+    encodedFrames = 0;
+    audioFrames = 0;
+    packetNumber = 0;
+}
+
+OpusWriter::~OpusWriter ()
+{
+    close ();
+}
+
+
+////////////////////////////////////////  SFML writer interface
+
+
+bool OpusWriter::open (const std::string& fileName, unsigned int rate, unsigned int channels)
+{
+    close ();
+
+    if (channels == 0 || channels > 2 || rate == 0)  // More channels would need the multistream mapping
+        return false;
+
+    inputRate = rate;
+    channelCount = channels;
+    encoderRate = std::find (std::begin (encoderRates), std::end (encoderRates), rate) != std::end (encoderRates) ? rate : granuleRate;
+    frameSize = encoderRate / 50;
+
+    if (!resampler.setup (inputRate, encoderRate, channelCount, Resampler::defaultQuality ()))
+        return false;
+
+
+    int error;
+    encoder = opus_encoder_create (encoderRate, channelCount, OPUS_APPLICATION_AUDIO, &error);
+
+    if (error != OPUS_OK)
+    {
+        encoder = nullptr;
+        return false;
+    }
+
+    file.open (fileName, std::ios::binary | std::ios::trunc);
+
+    if (!file)
+    {
+        opus_encoder_destroy (encoder);
+        encoder = nullptr;
+
+        return false;
+    }
+
+    opus_encoder_ctl (encoder, OPUS_SET_BITRATE (bitrate));
+    opus_encoder_ctl (encoder, OPUS_SET_COMPLEXITY (complexity));
+
+    opus_int32 encoderDelay = 0;
+    opus_encoder_ctl (encoder, OPUS_GET_LOOKAHEAD (&encoderDelay));
+
+    lookAhead = encoderDelay;
+    preSkip = lookAhead * (granuleRate / encoderRate);
+
+
+    encodedFrames = 0;
+    audioFrames = 0;
+    packetNumber = 0;
+
+    pendingSamples.clear ();
+    pendingSamples.reserve (frameSize * channelCount * 2);
+    packet.resize (maxPacketSize);
+
+
+    ogg_stream_init (&stream, std::random_device () () & 0x7FFFFFFF);
+    writeHeaders ();
+
+    return true;
+}
+
+void OpusWriter::write (const sf::Int16* samples, sf::Uint64 samplesCount)
+{
+    if (!encoder)
+        return;
+
+    if (encoderRate == inputRate)
+    {
+        pendingSamples.insert (pendingSamples.end (), samples, samples + samplesCount);
+        audioFrames += samplesCount / channelCount;
+    }
+    else
+        resample (samples, samplesCount);
+
+    encode (false);
+}
+
+
+////////////////////////////////////////  Encoding
+
+
+void OpusWriter::resample (const sf::Int16* samples, sf::Uint64 samplesCount)  // Towards 48 kHz, streamed block after block
+{
+    std::size_t first = pendingSamples.size ();
+    pendingSamples.resize (first + resampler.maxOutputSamples (samplesCount));
+
+    std::size_t outputSamples = samples ? resampler.process (samples, samplesCount, &pendingSamples[first])
+                                        : resampler.flush (&pendingSamples[first]);
+
+    pendingSamples.resize (first + outputSamples);
+    audioFrames += outputSamples / channelCount;
+}
+
+void OpusWriter::encode (bool last)  // Full packets only, the last one is padded with silence
+{
+    if (last)
+    {
+        pendingSamples.resize (pendingSamples.size () + lookAhead * channelCount, 0);  // Flushes the encoder delay
+        pendingSamples.resize ((pendingSamples.size () / channelCount + frameSize - 1) / frameSize * frameSize * channelCount, 0);
+    }
+
+    std::size_t packetSamples = frameSize * channelCount;
+    std::size_t offset = 0;
+
+    for ( ; pendingSamples.size () - offset >= packetSamples ; offset += packetSamples)
+    {
+        opus_int32 bytes = opus_encode (encoder, &pendingSamples[offset], frameSize, packet.data (), maxPacketSize);
+
+        if (bytes < 0)
+            bytes = 0;
+
+        encodedFrames += frameSize;
+        bool endOfStream = last && pendingSamples.size () - offset == packetSamples;
+
+
+        ogg_packet oggPacket;
+        oggPacket.packet = packet.data ();
+        oggPacket.bytes = bytes;
+        oggPacket.b_o_s = 0;
+        oggPacket.e_o_s = endOfStream;
+        oggPacket.granulepos = endOfStream ? preSkip + audioFrames * granuleRate / encoderRate  // Tells the decoder to drop the padding
+                                           : encodedFrames * (granuleRate / encoderRate);
+        oggPacket.packetno = packetNumber++;
+
+        ogg_stream_packetin (&stream, &oggPacket);
+        writePages (false);
+    }
+
+    pendingSamples.erase (pendingSamples.begin (), pendingSamples.begin () + offset);
+}
+
+void OpusWriter::writeHeaders ()  // Identification and comment headers, each one alone on its page
+{
+    std::vector<unsigned char> header {'O', 'p', 'u', 's', 'H', 'e', 'a', 'd', 1, (unsigned char) channelCount};
+    putLittleEndian (header, preSkip, 2);
+    putLittleEndian (header, inputRate, 4);
+    putLittleEndian (header, 0, 2);  // Output gain
+    header.push_back (0);  // Mapping family, mono or stereo
+
+
+    ogg_packet oggPacket;
+    oggPacket.packet = header.data ();
+    oggPacket.bytes = header.size ();
+    oggPacket.b_o_s = 1;
+    oggPacket.e_o_s = 0;
+    oggPacket.granulepos = 0;
+    oggPacket.packetno = packetNumber++;
+
+    ogg_stream_packetin (&stream, &oggPacket);
+    writePages (true);
+
+
+    const char* vendor = opus_get_version_string ();
+
+    std::vector<unsigned char> tags {'O', 'p', 'u', 's', 'T', 'a', 'g', 's'};
+    putLittleEndian (tags, std::strlen (vendor), 4);
+    tags.insert (tags.end (), vendor, vendor + std::strlen (vendor));
+    putLittleEndian (tags, 0, 4);  // No user comment
+
+    oggPacket.packet = tags.data ();
+    oggPacket.bytes = tags.size ();
+    oggPacket.b_o_s = 0;
+    oggPacket.packetno = packetNumber++;
+
+    ogg_stream_packetin (&stream, &oggPacket);
+    writePages (true);
+}
+
+void OpusWriter::writePages (bool flush)
+{
+    ogg_page page;
+
+    while (flush ? ogg_stream_flush (&stream, &page) : ogg_stream_pageout (&stream, &page))
+    {
+        file.write ((const char*) page.header, page.header_len);
+        file.write ((const char*) page.body, page.body_len);
+    }
+}
+
+
+void OpusWriter::close ()
+{
+    if (!encoder)
+        return;
+
+    if (encoderRate != inputRate)
+        resample (nullptr, 0);
+
+    encode (true);
+    writePages (true);
+
+    ogg_stream_clear (&stream);
+    opus_encoder_destroy (encoder);
+    encoder = nullptr;
+
+    file.close ();
+}
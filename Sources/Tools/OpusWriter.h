@@ -0,0 +1,63 @@
+#ifndef OPUSWRITER_H
+#define OPUSWRITER_H
+
+
+#include <SFML/Audio.hpp>
+
+#include <opus/opus.h>
+#include <ogg/ogg.h>
+
+#include <fstream>
+#include <vector>
+
+#include "Resampler.h"
+
+
+// Ogg/Opus encoder (RFC 7845), 20 ms packets, one or two channels
+// Opus only takes 8, 12, 16, 24 or 48 kHz, other rates are resampled to 48 kHz with the default quality of Resampler
+
+class OpusWriter : public sf::SoundFileWriter
+{
+    public:
+        OpusWriter (unsigned int, unsigned int);  // Bitrate in bits per second, complexity from 0 to 10
+        virtual ~OpusWriter ();
+
+        virtual bool open (const std::string&, unsigned int, unsigned int) override;
+        virtual void write (const sf::Int16*, sf::Uint64) override;
+
+
+    private:
+        void resample (const sf::Int16*, sf::Uint64);  // Without samples, flushes the resampler
+        void encode (bool);
+        void writeHeaders ();
+        void writePages (bool);
+
+        void close ();
+
+
+        std::ofstream file;
+
+        OpusEncoder* encoder;
+        ogg_stream_state stream;
+
+        unsigned int bitrate;
+        unsigned int complexity;
+
+        unsigned int inputRate;
+        unsigned int encoderRate;
+        unsigned int channelCount;
+        unsigned int frameSize;  // Per channel, at the encoder rate
+
+        unsigned int lookAhead;  // Encoder delay, at the encoder rate
+        unsigned int preSkip;  // The same at 48 kHz, like every Ogg/Opus position
+        unsigned long long int encodedFrames;  // Per channel, at the encoder rate, including the padding
+        unsigned long long int audioFrames;  // Without the padding
+        long long int packetNumber;
+
+        std::vector<sf::Int16> pendingSamples;
+        std::vector<unsigned char> packet;
+        Resampler resampler;
+};
+
+
+#endif // OPUSWRITER_H
@@ -0,0 +1,341 @@
+#include <QSaveFile>
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+
+#include "PeakFile.h"
+#include "CacheFiles.h"
+
+
+static const std::uint32_t formatVersion = 1;
+
+struct PeakFileHeader  // Followed by the levels, the finest first
+{
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t sampleRate;
+    std::uint32_t channelCount;
+    std::uint32_t blockFrames;
+    std::uint32_t levelCount;
+    std::uint64_t frames;
+    std::uint64_t audioSize;  // Recording the overview was built from
+    std::int64_t audioModified;
+};
+
+
+static std::vector<unsigned long long int> levelSizes (unsigned long long int frames)  // Half as many entries each level, up to a single one
+{
+    std::vector<unsigned long long int> sizes;
+
+    if (frames == 0)
+        return sizes;
+
+    sizes.push_back ((frames + PeakFile::blockFrames - 1) / PeakFile::blockFrames);
+
+    while (sizes.back () != 1)
+        sizes.push_back ((sizes.back () + 1) / 2);
+
+    return sizes;
+}
+
+static bool validHeader (const PeakFileHeader& header, const QString& recording)
+{
+    return std::memcmp (header.magic, "MRPK", 4) == 0 && header.version == formatVersion && header.blockFrames == PeakFile::blockFrames &&
+           header.channelCount != 0 && header.levelCount == levelSizes (header.frames).size () &&
+           CacheFiles::matches (recording, header.audioSize, header.audioModified);
+}
+
+static PeakEntry merge (const PeakEntry& first, const PeakEntry& second)
+{
+    double meanSquare = (double (first.rms) * first.rms + double (second.rms) * second.rms) / 2;
+
+    return {std::min (first.minimum, second.minimum), std::max (first.maximum, second.maximum), sf::Uint16 (std::lround (std::sqrt (meanSquare)))};
+}
+
+
+////////////////////////////////////////  Builder
+
+
+PeakBuilder::PeakBuilder ()
+{
+    begin (44100, 1);
+}
+
+
+void PeakBuilder::begin (unsigned int newSampleRate, unsigned int newChannelCount)
+{
+    sampleRate = newSampleRate;
+    channelCount = std::max (1U, newChannelCount);
+    frames = 0;
+
+    blockFramesCount = 0;
+    blockMinimum = 32767;
+    blockMaximum = -32768;
+    blockSquares = 0;
+
+    levels.clear ();
+}
+
+void PeakBuilder::add (const sf::Int16* samples, std::size_t samplesCount)
+{
+    std::size_t framesCount = samplesCount / channelCount;
+
+    while (framesCount != 0)
+    {
+        std::size_t blockPart = std::min<std::size_t> (framesCount, PeakFile::blockFrames - blockFramesCount);
+        std::size_t partSamples = blockPart * channelCount;
+
+        sf::Int16 minimum = blockMinimum;
+        sf::Int16 maximum = blockMaximum;
+        long long int squares = 0;
+
+        for (std::size_t i = 0 ; i != partSamples ; i++)
+        {
+            minimum = std::min (minimum, samples[i]);
+            maximum = std::max (maximum, samples[i]);
+            squares += int (samples[i]) * samples[i];
+        }
+
+        blockMinimum = minimum;
+        blockMaximum = maximum;
+        blockSquares += squares;
+        blockFramesCount += blockPart;
+        frames += blockPart;
+
+        samples += partSamples;
+        framesCount -= blockPart;
+
+        if (blockFramesCount == PeakFile::blockFrames)
+            addBlock ();
+    }
+}
+
+void PeakBuilder::addBlock ()
+{
+    PeakEntry entry = {blockMinimum, blockMaximum, sf::Uint16 (std::lround (std::sqrt (blockSquares / (double (blockFramesCount) * channelCount))))};
+
+    blockFramesCount = 0;
+    blockMinimum = 32767;
+    blockMaximum = -32768;
+    blockSquares = 0;
+
+
+    for (std::size_t level = 0 ; true ; level++)
+    {
+        if (levels.size () == level)
+            levels.emplace_back ();
+
+        levels[level].push_back (entry);
+
+        if (levels[level].size () % 2 != 0)
+            return;
+
+        entry = merge (levels[level][levels[level].size () - 2], levels[level].back ());
+    }
+}
+
+void PeakBuilder::completeLevels ()  // The last, partial blocks of every level
+{
+    if (blockFramesCount != 0)
+        addBlock ();
+
+    std::vector<unsigned long long int> sizes = levelSizes (frames);
+    levels.resize (sizes.size ());
+
+    for (std::size_t level = 1 ; level < sizes.size () ; level++)
+    {
+        std::vector<PeakEntry>& finer = levels[level - 1];
+
+        while (levels[level].size () < sizes[level])
+        {
+            std::size_t first = 2 * levels[level].size ();
+
+            levels[level].push_back (first + 1 < finer.size () ? merge (finer[first], finer[first + 1]) : finer[first]);
+        }
+    }
+}
+
+
+bool PeakBuilder::save (const QString& recording)
+{
+    completeLevels ();
+
+    PeakFileHeader header;
+    std::memcpy (header.magic, "MRPK", 4);
+    header.version = formatVersion;
+    header.sampleRate = sampleRate;
+    header.channelCount = channelCount;
+    header.blockFrames = PeakFile::blockFrames;
+    header.levelCount = levels.size ();
+    header.frames = frames;
+
+    unsigned long long int audioSize;
+    long long int audioModified;
+
+    CacheFiles::recordingState (recording, audioSize, audioModified);
+    header.audioSize = audioSize;
+    header.audioModified = audioModified;
+
+
+    QSaveFile file (CacheFiles::path (recording, "peaks"));
+
+    if (audioModified == 0 || !file.open (QIODevice::WriteOnly))
+        return false;
+
+    file.write (reinterpret_cast<const char*> (&header), sizeof (header));
+
+    for (const std::vector<PeakEntry>& level : levels)
+        file.write (reinterpret_cast<const char*> (&level[0]), level.size () * sizeof (PeakEntry));
+
+    return file.commit ();
+}
+
+
+////////////////////////////////////////  Reader
+
+
+PeakFile::PeakFile ()
+{
+    _frames = 0;
+    _sampleRate = 0;
+    _channelCount = 0;
+}
+
+
+bool PeakFile::open (const QString& recording)
+{
+    close ();
+
+    file.setFileName (CacheFiles::path (recording, "peaks"));
+
+    if (!file.open (QIODevice::ReadOnly) || file.size () < qint64 (sizeof (PeakFileHeader)))
+    {
+        close ();
+        return false;
+    }
+
+    const uchar* data = file.map (0, file.size ());
+    const PeakFileHeader* header = reinterpret_cast<const PeakFileHeader*> (data);
+
+    if (data == nullptr || !validHeader (*header, recording))
+    {
+        close ();
+        return false;
+    }
+
+
+    levelLengths = levelSizes (header->frames);
+
+    unsigned long long int entries = 0;
+
+    for (unsigned long long int size : levelLengths)
+        entries += size;
+
+    if ((unsigned long long int) file.size () != sizeof (PeakFileHeader) + entries * sizeof (PeakEntry))
+    {
+        close ();
+        return false;
+    }
+
+    const PeakEntry* level = reinterpret_cast<const PeakEntry*> (data + sizeof (PeakFileHeader));
+
+    for (unsigned long long int size : levelLengths)
+    {
+        levels.push_back (level);
+        level += size;
+    }
+
+    _frames = header->frames;
+    _sampleRate = header->sampleRate;
+    _channelCount = header->channelCount;
+
+    return true;
+}
+
+void PeakFile::close ()
+{
+    file.close ();  // Unmaps it too
+
+    levels.clear ();
+    levelLengths.clear ();
+
+    _frames = 0;
+    _sampleRate = 0;
+    _channelCount = 0;
+}
+
+bool PeakFile::isOpen () const
+{
+    return file.isOpen ();
+}
+
+
+unsigned long long int PeakFile::frames () const
+{
+    return _frames;
+}
+
+unsigned int PeakFile::sampleRate () const
+{
+    return _sampleRate;
+}
+
+unsigned int PeakFile::channelCount () const
+{
+    return _channelCount;
+}
+
+
+void PeakFile::overview (double firstFrame, double framesPerPixel, PeakEntry* pixels, unsigned int pixelsCount) const  // Empty entries past the end
+{
+    std::size_t level = 0;
+
+    while (level + 1 < levels.size () && double (blockFrames) * (1ULL << (level + 1)) <= framesPerPixel)
+        level++;
+
+    double entryFrames = double (blockFrames) * (1ULL << level);
+    long long int levelSize = levels.empty () ? 0 : levelLengths[level];
+
+
+    for (unsigned int pixel = 0 ; pixel != pixelsCount ; pixel++)
+    {
+        double start = (firstFrame + pixel * framesPerPixel) / entryFrames;
+        double end = (firstFrame + (pixel + 1) * framesPerPixel) / entryFrames;
+
+        long long int first = std::max (0LL, (long long int) std::floor (start));
+        long long int last = std::min (levelSize, std::max (first + 1, (long long int) std::ceil (end)));
+
+        if (first >= last || end <= 0)
+        {
+            pixels[pixel] = {0, 0, 0};
+            continue;
+        }
+
+        PeakEntry entry = levels[level][first];
+        double squares = double (entry.rms) * entry.rms;
+
+        for (long long int i = first + 1 ; i < last ; i++)  // Never more than a few, the level is chosen for that
+        {
+            const PeakEntry& next = levels[level][i];
+
+            entry.minimum = std::min (entry.minimum, next.minimum);
+            entry.maximum = std::max (entry.maximum, next.maximum);
+            squares += double (next.rms) * next.rms;
+        }
+
+        entry.rms = sf::Uint16 (std::lround (std::sqrt (squares / (last - first))));
+        pixels[pixel] = entry;
+    }
+}
+
+
+bool PeakFile::upToDate (const QString& recording)  // Only reads the header
+{
+    QFile sidecar (CacheFiles::path (recording, "peaks"));
+    PeakFileHeader header;
+
+    return sidecar.open (QIODevice::ReadOnly) && sidecar.read (reinterpret_cast<char*> (&header), sizeof (header)) == qint64 (sizeof (header)) &&
+           validHeader (header, recording);
+}
@@ -0,0 +1,88 @@
+#ifndef PEAKFILE_H
+#define PEAKFILE_H
+
+
+#include <QFile>
+
+#include <SFML/Audio.hpp>
+
+#include <vector>
+
+
+// Waveform overview of a recording : lowest and highest sample and RMS of every block of frames, all channels together,
+// then the same for blocks twice as long and so on, up to one entry for the whole file
+// Any zoom reads at most a few entries per pixel from the level whose blocks are just shorter than a pixel
+
+struct PeakEntry
+{
+    sf::Int16 minimum;
+    sf::Int16 maximum;
+    sf::Uint16 rms;
+};
+
+
+// Built while the samples go to the file or while reading it back, the levels above the first are filled as soon as two blocks are complete
+
+class PeakBuilder
+{
+    public:
+        PeakBuilder ();
+
+        void begin (unsigned int, unsigned int);  // Sample rate and channels, forgets the previous file
+        void add (const sf::Int16*, std::size_t);  // Whole interleaved frames
+        bool save (const QString&);  // Once the audio file is closed, its size and date are stored with the levels
+
+
+    private:
+        void addBlock ();
+        void completeLevels ();
+
+
+        unsigned int sampleRate;
+        unsigned int channelCount;
+        unsigned long long int frames;
+
+        unsigned int blockFramesCount;
+        sf::Int16 blockMinimum;
+        sf::Int16 blockMaximum;
+        double blockSquares;
+
+        std::vector<std::vector<PeakEntry>> levels;
+};
+
+
+// Read side : the sidecar is mapped in memory, nothing is loaded
+
+class PeakFile
+{
+    public:
+        PeakFile ();
+
+        bool open (const QString&);  // The audio file, false if its overview is missing or outdated
+        void close ();
+        bool isOpen () const;
+
+        unsigned long long int frames () const;
+        unsigned int sampleRate () const;
+        unsigned int channelCount () const;
+
+        void overview (double, double, PeakEntry*, unsigned int) const;  // First frame and frames per pixel, one entry per pixel
+
+        static bool upToDate (const QString&);
+
+        static const unsigned int blockFrames = 256;  // Frames of a first level entry
+
+
+    private:
+        QFile file;
+
+        unsigned long long int _frames;
+        unsigned int _sampleRate;
+        unsigned int _channelCount;
+
+        std::vector<const PeakEntry*> levels;
+        std::vector<unsigned long long int> levelLengths;
+};
+
+
+#endif // PEAKFILE_H
@@ -0,0 +1,100 @@
+#ifndef PREROLLBUFFER_H
+#define PREROLLBUFFER_H
+
+
+#include <vector>
+#include <algorithm>
+
+#include <SFML/Audio.hpp>
+
+
+// Fixed size history of the last captured samples, the oldest ones are overwritten, only the capture thread may use it
+
+class PreRollBuffer
+{
+    public:
+        PreRollBuffer () : position (0), filled (0) { }
+
+
+        void allocate (std::size_t capacity)
+        {
+            buffer.assign (capacity, 0);
+            clear ();
+        }
+
+        void clear ()
+        {
+            position = 0;
+            filled = 0;
+        }
+
+
+        void store (const sf::Int16* samples, std::size_t samplesCount)
+        {
+            if (buffer.empty ())
+                return;
+
+            if (samplesCount >= buffer.size ())  // Only the end of a huge chunk fits
+            {
+                std::copy (samples + samplesCount - buffer.size (), samples + samplesCount, buffer.begin ());
+
+                position = 0;
+                filled = buffer.size ();
+
+                return;
+            }
+
+            std::size_t firstPart = std::min (samplesCount, buffer.size () - position);
+
+            std::copy (samples, samples + firstPart, buffer.begin () + position);
+            std::copy (samples + firstPart, samples + samplesCount, buffer.begin ());
+
+            position = (position + samplesCount) % buffer.size ();
+            filled = std::min (buffer.size (), filled + samplesCount);
+        }
+
+
+        void dropOldest (std::size_t samplesCount)
+        {
+            filled -= std::min (samplesCount, filled);
+        }
+
+
+        // Stored samples from the oldest to the newest, split in two parts because of the wrap around
+
+        std::size_t oldestPart (const sf::Int16*& samples) const
+        {
+            std::size_t start = oldest ();
+            samples = buffer.data () + start;
+
+            return std::min (filled, buffer.size () - start);
+        }
+
+        std::size_t newestPart (const sf::Int16*& samples) const
+        {
+            samples = buffer.data ();
+
+            return filled - std::min (filled, buffer.size () - oldest ());
+        }
+
+        std::size_t size () const
+        {
+            return filled;
+        }
+
+
+    private:
+        std::size_t oldest () const
+        {
+            return buffer.empty () ? 0 : (position + buffer.size () - filled) % buffer.size ();
+        }
+
+
+        std::vector<sf::Int16> buffer;
+
+        std::size_t position;
+        std::size_t filled;
+};
+
+
+#endif // PREROLLBUFFER_H
@@ -0,0 +1,147 @@
+#include <QFile>
+#include <QFileInfo>
+
+#include <SFML/Audio.hpp>
+
+#include <fstream>
+
+#include "RecordingInfo.h"
+#include "CacheFiles.h"
+
+
+static QString codecName (const QString& fileName)  // From the first bytes, the suffix may lie
+{
+    QFile file (fileName);
+    QByteArray header;
+
+    if (file.open (QIODevice::ReadOnly))
+        header = file.read (64);
+
+    if (header.startsWith ("fLaC"))
+        return "FLAC";
+
+    if (header.startsWith ("OggS") && header.mid (28, 7) == "\x01vorbis")
+        return "Vorbis (OGG)";
+
+    if (header.startsWith ("OggS") && header.mid (28, 8) == "OpusHead")
+        return "Opus";
+
+    if (header.startsWith ("RIFF") && header.mid (8, 4) == "WAVE")
+        return "PCM (WAV)";
+
+    return QFileInfo (fileName).suffix ().toUpper ();
+}
+
+
+////////////////////////////////////////  Persistence
+
+
+void RecordingInfoCache::load (const QString& cacheFileName)  // One line per recording : name, size, date, duration, rate, channels and codec
+{
+    QFile cacheFile (cacheFileName);
+
+    if (!cacheFile.open (QIODevice::ReadOnly | QIODevice::Text))
+        return;
+
+    QStringList lines = QString (cacheFile.readAll ()).split ("\n");
+
+    std::lock_guard<std::mutex> lock (mutex);
+
+    for (const QString& line : lines)
+    {
+        QStringList fields = line.split ("\t");
+
+        if (fields.length () != 7)
+            continue;
+
+        RecordingInfo info;
+        info.size = fields.at (1).toULongLong ();
+        info.modified = fields.at (2).toLongLong ();
+        info.duration = fields.at (3).toLongLong ();
+        info.sampleRate = fields.at (4).toUInt ();
+        info.channelCount = fields.at (5).toUInt ();
+        info.codec = fields.at (6);
+
+        entries[fields.at (0)] = info;
+    }
+}
+
+void RecordingInfoCache::save (const QString& cacheFileName, const QStringList& recordings)
+{
+    std::ofstream cacheFile (cacheFileName.toStdString ());
+
+    std::lock_guard<std::mutex> lock (mutex);
+
+    for (const QString& recording : recordings)
+    {
+        auto entry = entries.find (recording);
+
+        if (entry == entries.end ())
+            continue;
+
+        const RecordingInfo& info = entry->second;
+
+        cacheFile<<recording.toStdString ()<<"\t"<<info.size<<"\t"<<info.modified<<"\t"<<info.duration<<"\t"
+                 <<info.sampleRate<<"\t"<<info.channelCount<<"\t"<<info.codec.toStdString ()<<"\n";
+    }
+}
+
+
+////////////////////////////////////////  Entries
+
+
+bool RecordingInfoCache::get (const QString& fileName, RecordingInfo& info)
+{
+    {
+        std::lock_guard<std::mutex> lock (mutex);
+
+        auto entry = entries.find (fileName);
+
+        if (entry != entries.end () && CacheFiles::matches (fileName, entry->second.size, entry->second.modified))
+        {
+            info = entry->second;
+            return true;
+        }
+    }
+
+    if (!read (fileName, info))  // Outside of the lock, the scanner may be reading another file
+        return false;
+
+    std::lock_guard<std::mutex> lock (mutex);
+    entries[fileName] = info;
+
+    return true;
+}
+
+void RecordingInfoCache::rename (const QString& oldFileName, const QString& newFileName)  // The file keeps its size and date, its entry stays valid
+{
+    std::lock_guard<std::mutex> lock (mutex);
+
+    auto entry = entries.find (oldFileName);
+
+    if (entry == entries.end ())
+        return;
+
+    RecordingInfo info = entry->second;
+
+    entries.erase (entry);
+    entries[newFileName] = info;
+}
+
+
+bool RecordingInfoCache::read (const QString& fileName, RecordingInfo& info)  // Only the headers : the Ogg and FLAC readers take the length from them
+{
+    CacheFiles::recordingState (fileName, info.size, info.modified);  // Before opening it, a later change is then detected
+
+    sf::InputSoundFile input;
+
+    if (info.modified == 0 || !input.openFromFile (std::string (fileName.toLocal8Bit ())) || input.getChannelCount () == 0)
+        return false;
+
+    info.codec = codecName (fileName);
+    info.sampleRate = input.getSampleRate ();
+    info.channelCount = input.getChannelCount ();
+    info.duration = input.getDuration ().asMilliseconds ();
+
+    return true;
+}
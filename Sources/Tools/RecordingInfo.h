@@ -0,0 +1,47 @@
+#ifndef RECORDINGINFO_H
+#define RECORDINGINFO_H
+
+
+#include <QString>
+#include <QStringList>
+
+#include <map>
+#include <mutex>
+
+
+// What the recordings tab shows of a recording, with the size and modification date of the file it was read from
+
+struct RecordingInfo
+{
+    QString codec;
+    unsigned int sampleRate;
+    unsigned int channelCount;
+    long long int duration;  // In milliseconds
+
+    unsigned long long int size;
+    long long int modified;
+};
+
+
+// Read once from the headers of each recording then kept between launches, next to the list : selecting a recording
+// or showing its properties never opens a decoder. An entry whose file changed since is read again
+
+class RecordingInfoCache
+{
+    public:
+        void load (const QString&);
+        void save (const QString&, const QStringList&);  // Only the entries of the listed recordings are kept
+
+        bool get (const QString&, RecordingInfo&);  // False if the file is missing or cannot be decoded
+        void rename (const QString&, const QString&);
+
+        static bool read (const QString&, RecordingInfo&);
+
+
+    private:
+        std::map<QString, RecordingInfo> entries;
+        std::mutex mutex;  // Also filled by the recording scanner
+};
+
+
+#endif // RECORDINGINFO_H
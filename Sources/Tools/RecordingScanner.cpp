@@ -0,0 +1,102 @@
+#include <SFML/Audio.hpp>
+
+#include <vector>
+
+#include "RecordingScanner.h"
+#include "PeakFile.h"
+#include "SeekIndex.h"
+
+
+RecordingScanner::RecordingScanner (RecordingInfoCache* recordingsInfo, QObject* parent) : QThread (parent)
+{
+    infoCache = recordingsInfo;
+
+    idle = true;
+    stopRequested = false;
+}
+
+RecordingScanner::~RecordingScanner ()
+{
+    stopRequested = true;
+    wait ();
+}
+
+
+void RecordingScanner::scan (const QString& fileName)  // Nothing is done if its cached data is up to date
+{
+    bool startNeeded;
+
+    {
+        std::lock_guard<std::mutex> lock (queueMutex);
+
+        if (!queue.contains (fileName))
+            queue.append (fileName);
+
+        startNeeded = idle;
+        idle = false;
+    }
+
+    if (startNeeded)
+    {
+        wait ();  // The thread may still be returning from its last run
+        start (QThread::LowPriority);
+    }
+}
+
+
+void RecordingScanner::run ()
+{
+    while (!stopRequested)
+    {
+        QString fileName;
+
+        {
+            std::lock_guard<std::mutex> lock (queueMutex);
+
+            if (queue.isEmpty ())
+            {
+                idle = true;
+                return;
+            }
+
+            fileName = queue.takeFirst ();
+        }
+
+        bool built = !PeakFile::upToDate (fileName) && buildPeaks (fileName);
+
+        if (SeekIndex::supported (fileName) && !SeekIndex::upToDate (fileName))
+            built = SeekIndexBuilder ().scan (fileName, stopRequested) || built;
+
+        RecordingInfo info;
+        infoCache->get (fileName, info);  // Read now if the cache has nothing valid, the selection then needs no file access
+
+        if (built)
+            emit scanned (fileName);
+    }
+}
+
+
+bool RecordingScanner::buildPeaks (const QString& fileName)
+{
+    sf::InputSoundFile input;
+
+    if (!input.openFromFile (std::string (fileName.toLocal8Bit ())) || input.getChannelCount () == 0)
+        return false;
+
+    PeakBuilder peaks;
+    peaks.begin (input.getSampleRate (), input.getChannelCount ());
+
+    std::vector<sf::Int16> buffer (65536 / input.getChannelCount () * input.getChannelCount ());
+    sf::Uint64 readSamples = input.read (&buffer[0], buffer.size ());
+
+    while (readSamples != 0)
+    {
+        if (stopRequested)  // Left for the next launch
+            return false;
+
+        peaks.add (&buffer[0], readSamples);
+        readSamples = input.read (&buffer[0], buffer.size ());
+    }
+
+    return peaks.save (fileName);
+}
@@ -0,0 +1,49 @@
+#ifndef RECORDINGSCANNER_H
+#define RECORDINGSCANNER_H
+
+
+#include <QThread>
+#include <QStringList>
+
+#include <atomic>
+#include <mutex>
+
+#include "RecordingInfo.h"
+
+
+// Background pass over the recordings that were not made here, or changed since : decodes them once to build their waveform overview,
+// and reads the page or frame headers of the compressed ones for their seek index, and the headers of every recording for the list's cache
+// The queue is processed in order, the thread only runs while it is not empty
+
+class RecordingScanner : public QThread
+{
+    Q_OBJECT
+
+    public:
+        RecordingScanner (RecordingInfoCache*, QObject* = nullptr);
+        virtual ~RecordingScanner ();
+
+        void scan (const QString&);
+
+
+    signals:
+        void scanned (const QString&);
+
+
+    private:
+        virtual void run () override;
+
+        bool buildPeaks (const QString&);
+
+
+        RecordingInfoCache* infoCache;
+
+        std::mutex queueMutex;
+        QStringList queue;
+        bool idle;
+
+        std::atomic<bool> stopRequested;
+};
+
+
+#endif // RECORDINGSCANNER_H
@@ -0,0 +1,418 @@
+#include <algorithm>
+
+#include "RecordingSession.h"
+
+
+static const std::chrono::milliseconds alignmentDelay (250);  // Leaves time to every device to open before the common start
+static const std::chrono::milliseconds maxStartDelay (30000);  // Audio kept beyond the pre-roll while the output file is chosen
+static const std::chrono::milliseconds startMargin (1000);  // Callbacks between the start and the first write of the pre-roll
+
+
+////////////////////////////////////////  Constructor / Destructor
+
+
+RecordingSession::RecordingSession (QObject* parent) : QObject (parent)
+{
+    _outputMode = SeparateFiles;
+    _volume = 100;
+    overloadProtection = AudioRecorder::Clipping;
+    _bufferDuration = 2000;
+    _latency = 20;
+    _preRoll = 0;
+    startMarked = false;
+
+    _silenceGate = false;
+    silenceThreshold = -45;
+    silenceHangover = 2000;
+
+    segmentDuration = 0;
+    segmentBytes = 0;
+
+    memoryBudget = 0;
+    captureRate = 0;
+
+    multichannel = false;
+
+    recorders.emplace_back (new AudioRecorder);
+    devices.push_back (sf::SoundRecorder::getDefaultDevice ());
+
+    connect (recorders.at (0).get (), SIGNAL (started ()), this, SIGNAL (started ()));
+    connect (recorders.at (0).get (), SIGNAL (segmentCompleted (QString)), this, SIGNAL (segmentCompleted (QString)));
+    connect (&multichannelWriter, SIGNAL (segmentCompleted (QString)), this, SIGNAL (segmentCompleted (QString)));
+}
+
+RecordingSession::~RecordingSession ()
+{
+    stop ();
+}
+
+
+////////////////////////////////////////  Controls
+
+
+void RecordingSession::markStart ()
+{
+    startMark = std::chrono::steady_clock::now ();
+    startMarked = true;
+}
+
+bool RecordingSession::start (const std::string& fileName, unsigned int sampleRate, unsigned int channelCount)
+{
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now ();
+    std::chrono::steady_clock::time_point requested = startMarked ? std::max (startMark, now - maxStartDelay) : now;  // Past the delay, the press is not in the pre-roll anymore
+
+    startMarked = false;
+
+    unsigned int deviceRate = captureRate != 0 ? captureRate : sampleRate;
+
+    _outputFiles.clear ();
+
+    multichannel = _outputMode == MultichannelFile && recorders.size () > 1;
+
+    if (multichannel)
+    {
+        _outputFiles.push_back (fileName);
+
+        multichannelWriter.setBufferDuration (std::max (_bufferDuration, 4 * _latency + monitoredDuration ()));
+        multichannelWriter.setSegmentLimits (segmentDuration, segmentBytes);
+        multichannelWriter.setMemoryBudget (memoryBudget);
+        multichannelWriter.setInputRate (deviceRate);
+
+        if (!multichannelWriter.open (fileName, sampleRate, std::vector<unsigned int> (recorders.size (), channelCount)))
+            return false;
+
+        multichannelWriter.begin ();
+    }
+
+
+    // A device already monitored in the right format just has to write its pre-roll and go on
+    std::vector<bool> monitored;
+
+    for (unsigned short int i = 0 ; i != recorders.size () ; i++)
+        monitored.push_back (recorders.at (i)->monitoring () && recorders.at (i)->getDevice () == devices.at (i) &&
+                             recorders.at (i)->getSampleRate () == deviceRate && recorders.at (i)->getChannelCount () == channelCount);
+
+    // With a pre-roll, every track starts one pre-roll before the press of start, whatever time the file dialog took,
+    // the devices opened now are padded with silence up to their first sample
+    bool preRolled = std::find (monitored.begin (), monitored.end (), true) != monitored.end ();
+
+    std::chrono::steady_clock::time_point startTime = preRolled ? requested - std::chrono::milliseconds (_preRoll) : now + alignmentDelay;
+
+    for (unsigned short int i = 0 ; i != recorders.size () ; i++)
+    {
+        AudioRecorder* currentRecorder = recorders.at (i).get ();
+
+        if (!monitored.at (i))
+        {
+            currentRecorder->stop ();
+            currentRecorder->setLatency (_latency);
+            currentRecorder->setOverloadProtection (overloadProtection);
+        }
+
+        currentRecorder->setBufferDuration (_bufferDuration);
+        currentRecorder->setSilenceGate (_silenceGate, silenceThreshold, silenceHangover);
+        currentRecorder->setSegmentLimits (segmentDuration, segmentBytes);
+        currentRecorder->setMemoryBudget (memoryBudget != 0 ? std::max (1U, memoryBudget / (unsigned int) recorders.size ()) : 0);  // Shared between the files
+
+        if (multichannel)
+            currentRecorder->shareWriter (&multichannelWriter, i);
+
+        else
+        {
+            currentRecorder->shareWriter (nullptr, 0);
+            _outputFiles.push_back (i == 0 ? fileName : numberedFileName (fileName, i + 1));
+
+            if (!currentRecorder->setOutputStream (_outputFiles.back (), sampleRate, channelCount))
+            {
+                stop ();
+                return false;
+            }
+        }
+
+        if (recorders.size () > 1 || monitored.at (i))
+            currentRecorder->alignTo (startTime);
+
+        if (monitored.at (i))
+        {
+            currentRecorder->record ();
+            continue;
+        }
+
+        if (!currentRecorder->setDevice (devices.at (i)))
+        {
+            stop ();
+            return false;
+        }
+
+        currentRecorder->setChannelCount (channelCount);
+
+        if (!currentRecorder->start (deviceRate))
+        {
+            stop ();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool RecordingSession::monitor (unsigned int sampleRate, unsigned int channelCount)  // Capture every device into its pre-roll until start is called
+{
+    stop ();
+
+    for (unsigned short int i = 0 ; i != recorders.size () ; i++)
+    {
+        AudioRecorder* currentRecorder = recorders.at (i).get ();
+
+        currentRecorder->setLatency (_latency);
+        currentRecorder->setPreRoll (monitoredDuration ());
+        currentRecorder->setOverloadProtection (overloadProtection);
+        currentRecorder->setChannelCount (channelCount);
+
+        if (!currentRecorder->setDevice (devices.at (i)) || !currentRecorder->monitor (captureRate != 0 ? captureRate : sampleRate))
+        {
+            stop ();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void RecordingSession::stop ()
+{
+    for (unsigned short int i = 0 ; i != recorders.size () ; i++)
+        recorders.at (i)->stop ();
+
+    multichannelWriter.finish ();
+}
+
+
+void RecordingSession::pause ()
+{
+    for (unsigned short int i = 0 ; i != recorders.size () ; i++)
+        recorders.at (i)->pause ();
+}
+
+void RecordingSession::resume ()
+{
+    for (unsigned short int i = 0 ; i != recorders.size () ; i++)
+        recorders.at (i)->resume ();
+}
+
+
+bool RecordingSession::paused ()
+{
+    return recorders.at (0)->paused ();
+}
+
+bool RecordingSession::recording ()
+{
+    return recorders.at (0)->recording ();
+}
+
+bool RecordingSession::monitoring ()
+{
+    return recorders.at (0)->monitoring ();
+}
+
+
+////////////////////////////////////////  Settings
+
+
+void RecordingSession::setDevices (const std::vector<std::string>& newDevices)  // The first device is the main one, its recorder is never replaced
+{
+    if (newDevices.empty ())
+        return;
+
+    devices = newDevices;
+
+    while (recorders.size () > devices.size ())
+        recorders.pop_back ();
+
+    while (recorders.size () < devices.size ())
+    {
+        recorders.emplace_back (new AudioRecorder);
+        recorders.back ()->setVolume (_volume);
+
+        connect (recorders.back ().get (), SIGNAL (segmentCompleted (QString)), this, SIGNAL (segmentCompleted (QString)));
+    }
+}
+
+void RecordingSession::setOutputMode (OutputMode mode)
+{
+    _outputMode = mode;
+}
+
+void RecordingSession::setVolume (unsigned short int volume)
+{
+    _volume = volume;
+
+    for (unsigned short int i = 0 ; i != recorders.size () ; i++)
+        recorders.at (i)->setVolume (volume);
+}
+
+void RecordingSession::setOverloadProtection (AudioRecorder::OverloadProtection protection)  // Applied at next start or monitoring
+{
+    overloadProtection = protection;
+}
+
+void RecordingSession::setBufferDuration (unsigned int milliseconds)
+{
+    _bufferDuration = milliseconds;
+}
+
+void RecordingSession::setLatency (unsigned int milliseconds)
+{
+    _latency = milliseconds;
+}
+
+void RecordingSession::setPreRoll (unsigned int milliseconds)
+{
+    _preRoll = milliseconds;
+}
+
+void RecordingSession::setSilenceGate (bool enabled, float threshold, unsigned int hangover)  // Only used with separate files, skipping one input would desynchronize a multichannel file
+{
+    _silenceGate = enabled;
+    silenceThreshold = threshold;
+    silenceHangover = hangover;
+}
+
+void RecordingSession::setSegmentLimits (unsigned int seconds, unsigned long long int bytes)  // Long recordings are split in several files, 0 for no limit
+{
+    segmentDuration = seconds;
+    segmentBytes = bytes;
+}
+
+void RecordingSession::setCaptureRate (unsigned int sampleRate)  // Rate asked to the devices, files are resampled to their own rate, 0 to capture at the file rate
+{
+    captureRate = sampleRate;
+}
+
+void RecordingSession::setSpectrumAnalysis (bool enabled)  // Only the main device is analyzed, applied at next start or monitoring
+{
+    recorders.at (0)->setSpectrumAnalysis (enabled);
+}
+
+void RecordingSession::setMemoryBudget (unsigned int megabytes)  // Recording goes to RAM first and reaches the disk by large batches, 0 to write directly
+{
+    memoryBudget = megabytes;
+}
+
+
+////////////////////////////////////////  Others
+
+
+AudioRecorder* RecordingSession::mainRecorder ()
+{
+    return recorders.at (0).get ();
+}
+
+AudioRecorder* RecordingSession::recorder (unsigned int index)
+{
+    return recorders.at (index).get ();
+}
+
+unsigned int RecordingSession::recordersCount ()
+{
+    return recorders.size ();
+}
+
+
+std::vector<std::string> RecordingSession::outputFiles ()  // Every file of the last recording, with all their segments once stopped
+{
+    if (multichannel)
+        return multichannelWriter.files ();
+
+    if (recorders.size () != _outputFiles.size ())  // Start failed before every file was opened
+        return _outputFiles;
+
+
+    std::vector<std::string> files;
+
+    for (unsigned short int i = 0 ; i != recorders.size () ; i++)
+    {
+        const std::vector<std::string>& segments = recorders.at (i)->outputFiles ();
+
+        files.insert (files.end (), segments.begin (), segments.end ());
+    }
+
+    return files;
+}
+
+
+unsigned int RecordingSession::durationAsMilliseconds ()
+{
+    return recorders.at (0)->durationAsMilliseconds ();
+}
+
+unsigned int RecordingSession::bufferOverruns ()
+{
+    if (multichannel)
+        return multichannelWriter.overruns ();
+
+
+    unsigned int overruns = 0;
+
+    for (unsigned short int i = 0 ; i != recorders.size () ; i++)
+        overruns += recorders.at (i)->bufferOverruns ();
+
+    return overruns;
+}
+
+
+unsigned long long int RecordingSession::memoryUsed ()
+{
+    if (multichannel)
+        return multichannelWriter.memoryUsed ();
+
+
+    unsigned long long int used = 0;
+
+    for (unsigned short int i = 0 ; i != recorders.size () ; i++)
+        used += recorders.at (i)->memoryUsed ();
+
+    return used;
+}
+
+unsigned long long int RecordingSession::droppedFrames ()
+{
+    if (multichannel)
+        return multichannelWriter.droppedFrames ();
+
+
+    unsigned long long int dropped = 0;
+
+    for (unsigned short int i = 0 ; i != recorders.size () ; i++)
+        dropped += recorders.at (i)->droppedFrames ();
+
+    return dropped;
+}
+
+
+unsigned int RecordingSession::captureGaps ()  // Audio lost by the devices themselves, before reaching the writers
+{
+    unsigned int gaps = 0;
+
+    for (unsigned short int i = 0 ; i != recorders.size () ; i++)
+        gaps += recorders.at (i)->timings ().gaps ();
+
+    return gaps;
+}
+
+
+std::string RecordingSession::numberedFileName (const std::string& fileName, unsigned int number)  // "Take.ogg" becomes "Take (2).ogg"
+{
+    std::size_t extensionIndex = fileName.find_last_of ('.');
+
+    if (extensionIndex == std::string::npos || fileName.find_first_of ("/\\", extensionIndex) != std::string::npos)
+        return fileName + " (" + std::to_string (number) + ")";
+
+    return fileName.substr (0, extensionIndex) + " (" + std::to_string (number) + ")" + fileName.substr (extensionIndex);
+}
+
+unsigned int RecordingSession::monitoredDuration ()  // Milliseconds kept while monitoring : the pre-roll, and the time to choose the file after the press of start
+{
+    return _preRoll != 0 ? _preRoll + (unsigned int) (maxStartDelay + startMargin).count () : 0;
+}
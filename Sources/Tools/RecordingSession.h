@@ -0,0 +1,107 @@
+#ifndef RECORDINGSESSION_H
+#define RECORDINGSESSION_H
+
+
+#include <QObject>
+
+#include <memory>
+
+#include "AudioRecorder.h"
+
+
+// Records several devices at once, each one with its own capture thread, starts are aligned on a common timestamp
+
+class RecordingSession : public QObject
+{
+    Q_OBJECT
+
+    public:
+        enum OutputMode
+        {
+            SeparateFiles,
+            MultichannelFile
+        };
+
+
+        RecordingSession (QObject* = nullptr);
+        virtual ~RecordingSession ();
+
+
+        void markStart ();  // When the user asked to record, the pre-roll is counted back from there
+        bool start (const std::string&, unsigned int, unsigned int);
+        bool monitor (unsigned int, unsigned int);
+        void stop ();
+
+        void pause ();
+        void resume ();
+
+        bool paused ();
+        bool recording ();
+        bool monitoring ();
+
+        void setDevices (const std::vector<std::string>&);
+        void setOutputMode (OutputMode);
+        void setVolume (unsigned short int);
+        void setOverloadProtection (AudioRecorder::OverloadProtection);
+        void setBufferDuration (unsigned int);
+        void setLatency (unsigned int);
+        void setPreRoll (unsigned int);
+        void setSilenceGate (bool, float, unsigned int);
+        void setSegmentLimits (unsigned int, unsigned long long int);
+        void setMemoryBudget (unsigned int);
+        void setCaptureRate (unsigned int);
+        void setSpectrumAnalysis (bool);
+
+        AudioRecorder* mainRecorder ();
+        AudioRecorder* recorder (unsigned int);
+        unsigned int recordersCount ();
+
+        std::vector<std::string> outputFiles ();
+
+        unsigned int durationAsMilliseconds ();
+        unsigned int bufferOverruns ();
+        unsigned long long int memoryUsed ();
+        unsigned long long int droppedFrames ();
+        unsigned int captureGaps ();
+
+
+    signals:
+        void started ();
+        void segmentCompleted (const QString&);
+
+
+    private:
+        static std::string numberedFileName (const std::string&, unsigned int);
+        unsigned int monitoredDuration ();
+
+
+        std::vector<std::unique_ptr<AudioRecorder>> recorders;
+        std::vector<std::string> devices;
+        std::vector<std::string> _outputFiles;
+
+        OutputMode _outputMode;
+        unsigned short int _volume;
+        AudioRecorder::OverloadProtection overloadProtection;
+        unsigned int _bufferDuration;
+        unsigned int _latency;
+        unsigned int _preRoll;
+        bool startMarked;
+        std::chrono::steady_clock::time_point startMark;
+
+        bool _silenceGate;
+        float silenceThreshold;
+        unsigned int silenceHangover;
+
+        unsigned int segmentDuration;
+        unsigned long long int segmentBytes;
+
+        unsigned int memoryBudget;
+        unsigned int captureRate;
+
+        bool multichannel;
+
+        SamplesWriter multichannelWriter;
+};
+
+
+#endif // RECORDINGSESSION_H
@@ -0,0 +1,109 @@
+#include <QFileInfo>
+
+#include "RecordingStream.h"
+#include "VorbisReader.h"
+#include "FlacReader.h"
+#include "OpusReader.h"
+
+
+RecordingStream::RecordingStream ()
+{
+    duration = sf::Time::Zero;
+}
+
+RecordingStream::~RecordingStream ()
+{
+    stop ();  // The streaming thread must not outlive the reader
+}
+
+
+bool RecordingStream::openFromFile (const std::string& fileName)
+{
+    stop ();
+
+    std::lock_guard<std::mutex> lock (mutex);
+
+    close ();
+
+    if (fileName.empty ())
+        return false;
+
+
+    stream.reset (new sf::FileInputStream);
+
+    if (!stream->open (fileName))
+    {
+        close ();
+        return false;
+    }
+
+    QString recording = QString::fromLocal8Bit (fileName.c_str ());
+    QString suffix = QFileInfo (recording).suffix ().toLower ();
+
+    index.open (recording);  // Without it, seeks are left to the decoders' own search
+
+    if (suffix == "ogg")
+        reader.reset (new VorbisReader (&index));
+
+    else if (suffix == "flac")
+        reader.reset (new FlacReader (&index));
+
+    else if (suffix == "opus")
+        reader.reset (new OpusReader);
+
+    else
+        reader.reset (sf::SoundFileFactory::createReaderFromStream (*stream));
+
+
+    sf::SoundFileReader::Info info;
+
+    if (!reader || stream->seek (0) != 0 || !reader->open (*stream, info) || info.channelCount == 0 || info.sampleRate == 0)
+    {
+        close ();
+        return false;
+    }
+
+    duration = sf::seconds (float (info.sampleCount / info.channelCount) / info.sampleRate);
+    samples.resize (info.sampleRate * info.channelCount);  // One second per chunk, as sf::Music
+
+    initialize (info.channelCount, info.sampleRate);
+
+    return true;
+}
+
+void RecordingStream::close ()
+{
+    reader.reset ();
+    index.close ();
+    stream.reset ();
+
+    duration = sf::Time::Zero;
+}
+
+
+sf::Time RecordingStream::getDuration () const
+{
+    return duration;
+}
+
+
+bool RecordingStream::onGetData (Chunk& data)
+{
+    std::lock_guard<std::mutex> lock (mutex);
+
+    if (!reader)
+        return false;
+
+    data.samples = &samples[0];
+    data.sampleCount = std::size_t (reader->read (&samples[0], samples.size ()));
+
+    return data.sampleCount == samples.size ();
+}
+
+void RecordingStream::onSeek (sf::Time offset)
+{
+    std::lock_guard<std::mutex> lock (mutex);
+
+    if (reader)
+        reader->seek (sf::Uint64 (offset.asMicroseconds () * getSampleRate () / 1000000) * getChannelCount ());
+}
@@ -0,0 +1,47 @@
+#ifndef RECORDINGSTREAM_H
+#define RECORDINGSTREAM_H
+
+
+#include <SFML/Audio.hpp>
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "SeekIndex.h"
+
+
+// Player of the recordings, used like sf::Music : Ogg Vorbis, FLAC and Opus files are decoded by our readers,
+// the first two seek through the index of the file when it has one, the other formats are left to the SFML ones
+
+class RecordingStream : public sf::SoundStream
+{
+    public:
+        RecordingStream ();
+        ~RecordingStream ();
+
+        bool openFromFile (const std::string&);  // An empty name only releases the current file
+        sf::Time getDuration () const;
+
+
+    protected:
+        virtual bool onGetData (Chunk&) override;
+        virtual void onSeek (sf::Time) override;
+
+
+    private:
+        void close ();
+
+
+        std::unique_ptr<sf::FileInputStream> stream;
+        std::unique_ptr<sf::SoundFileReader> reader;
+        SeekIndex index;
+
+        std::vector<sf::Int16> samples;
+        sf::Time duration;
+
+        std::mutex mutex;
+};
+
+
+#endif // RECORDINGSTREAM_H
@@ -0,0 +1,329 @@
+#include <atomic>
+#include <cmath>
+#include <numeric>
+#include <algorithm>
+
+#include "Resampler.h"
+
+#if defined (__x86_64__) || defined (_M_X64) || defined (__i386__) || defined (_M_IX86)
+    #define RESAMPLER_X86
+    #include <immintrin.h>
+#endif
+
+
+static const unsigned int maxPhases = 8192;
+static const double pi = 3.14159265358979323846;
+
+struct QualitySettings
+{
+    unsigned int taps;  // Per phase without decimation, more when the output rate is lower
+    double beta;  // Kaiser window, the stopband attenuation grows with it
+    double passband;  // Part of the lowest Nyquist frequency kept
+};
+
+static const QualitySettings qualities[] = {{16, 6, 0.85}, {32, 8, 0.91}, {64, 10, 0.95}};
+
+static std::atomic<int> defaultQualitySetting (Resampler::Balanced);
+
+
+static double besselI0 (double x)
+{
+    double sum = 1, term = 1;
+
+    for (unsigned int k = 1 ; term > sum * 1e-12 ; k++)
+    {
+        term *= (x / (2 * k)) * (x / (2 * k));
+        sum += term;
+    }
+
+    return sum;
+}
+
+
+////////////////////////////////////////  Dot products, every length is a multiple of 8
+
+
+static float dotScalar (const float* samples, const float* coefficients, unsigned int length)
+{
+    float sums[4] = {0, 0, 0, 0};
+
+    for (unsigned int i = 0 ; i != length ; i += 4)
+        for (unsigned short int lane = 0 ; lane != 4 ; lane++)
+            sums[lane] += samples[i + lane] * coefficients[i + lane];
+
+    return (sums[0] + sums[1]) + (sums[2] + sums[3]);
+}
+
+#ifdef RESAMPLER_X86
+
+#if defined (__GNUC__) || defined (__clang__)
+__attribute__ ((target ("sse2")))
+#endif
+static float dotSSE2 (const float* samples, const float* coefficients, unsigned int length)
+{
+    __m128 first = _mm_setzero_ps ();
+    __m128 second = _mm_setzero_ps ();
+
+    for (unsigned int i = 0 ; i != length ; i += 8)
+    {
+        first = _mm_add_ps (first, _mm_mul_ps (_mm_loadu_ps (samples + i), _mm_loadu_ps (coefficients + i)));
+        second = _mm_add_ps (second, _mm_mul_ps (_mm_loadu_ps (samples + i + 4), _mm_loadu_ps (coefficients + i + 4)));
+    }
+
+    float lanes[4];
+    _mm_storeu_ps (lanes, _mm_add_ps (first, second));
+
+    return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+}
+
+#if defined (__GNUC__) || defined (__clang__)
+__attribute__ ((target ("avx2")))
+#endif
+static float dotAVX2 (const float* samples, const float* coefficients, unsigned int length)
+{
+    __m256 sum = _mm256_setzero_ps ();
+
+    for (unsigned int i = 0 ; i != length ; i += 8)
+        sum = _mm256_add_ps (sum, _mm256_mul_ps (_mm256_loadu_ps (samples + i), _mm256_loadu_ps (coefficients + i)));
+
+    __m128 half = _mm_add_ps (_mm256_castps256_ps128 (sum), _mm256_extractf128_ps (sum, 1));
+
+    float lanes[4];
+    _mm_storeu_ps (lanes, half);
+
+    return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+}
+
+#endif // RESAMPLER_X86
+
+
+typedef float (*DotFunction) (const float*, const float*, unsigned int);
+
+struct DotImplementation
+{
+    DotFunction function;
+    const char* name;
+};
+
+static DotImplementation selectImplementation ()
+{
+    #ifdef RESAMPLER_X86
+        #if defined (__GNUC__) || defined (__clang__)
+            __builtin_cpu_init ();
+
+            if (__builtin_cpu_supports ("avx2"))
+                return {dotAVX2, "AVX2"};
+
+            if (__builtin_cpu_supports ("sse2"))
+                return {dotSSE2, "SSE2"};
+        #else
+            return {dotSSE2, "SSE2"};
+        #endif
+    #endif
+
+    return {dotScalar, "scalar"};
+}
+
+static const DotImplementation selectedImplementation = selectImplementation ();
+
+
+////////////////////////////////////////  Setup
+
+
+Resampler::Resampler ()
+{
+    channelCount = 1;
+    upFactor = 1;
+    downFactor = 1;
+    taps = 0;
+
+    position = 0;
+    inputFrames = 0;
+    outputFrames = 0;
+}
+
+
+bool Resampler::setup (unsigned int inputRate, unsigned int outputRate, unsigned int channels, Quality quality)
+{
+    if (inputRate == 0 || outputRate == 0 || channels == 0)
+        return false;
+
+    unsigned int divisor = std::gcd (inputRate, outputRate);
+
+    if (outputRate / divisor > maxPhases)
+        return false;
+
+    channelCount = channels;
+    upFactor = outputRate / divisor;
+    downFactor = inputRate / divisor;
+
+    coefficients.clear ();
+    history.assign (channelCount, std::vector<float> ());
+
+    if (passthrough ())
+    {
+        taps = 0;
+        reset ();
+
+        return true;
+    }
+
+
+    const QualitySettings& settings = qualities[quality];
+
+    double decimation = std::max (1.0, double (downFactor) / upFactor);
+    taps = (unsigned int) std::ceil (settings.taps * decimation / 8) * 8;
+
+    unsigned long long int length = (unsigned long long int) taps * upFactor;
+    double center = (length - 1) / 2;  // On a sample of the upsampled signal, where reset puts the first output
+    double cutoff = 0.5 * settings.passband / std::max (upFactor, downFactor);  // In cycles per sample of the upsampled signal
+    double windowNorm = besselI0 (settings.beta);
+
+    coefficients.resize (length);
+
+    for (unsigned long long int i = 0 ; i != length ; i++)
+    {
+        double offset = i - center;
+        double sinc = offset == 0 ? 1 : std::sin (2 * pi * cutoff * offset) / (2 * pi * cutoff * offset);
+        double windowPosition = offset / (center + 1);
+        double window = besselI0 (settings.beta * std::sqrt (std::max (0.0, 1 - windowPosition * windowPosition))) / windowNorm;
+
+        double value = upFactor * 2 * cutoff * sinc * window;
+
+        unsigned int phase = i % upFactor;
+        unsigned int tap = taps - 1 - i / upFactor;
+
+        coefficients[phase * taps + tap] = value;
+    }
+
+    reset ();
+
+    return true;
+}
+
+void Resampler::reset ()  // Forget the history, for a new stream with the same format
+{
+    for (std::vector<float>& channelHistory : history)
+        channelHistory.assign (taps != 0 ? taps - 1 : 0, 0);
+
+    position = taps != 0 ? ((unsigned long long int) taps * upFactor - 1) / 2 : 0;  // The filter center, so that output and input instants match
+    inputFrames = 0;
+    outputFrames = 0;
+}
+
+
+////////////////////////////////////////  Processing
+
+
+bool Resampler::passthrough () const
+{
+    return upFactor == downFactor;
+}
+
+std::size_t Resampler::maxOutputSamples (std::size_t inputSamples) const  // Enough for one process or flush call with this input
+{
+    if (passthrough ())
+        return inputSamples;
+
+    return ((inputSamples / channelCount + taps) * upFactor / downFactor + 2) * channelCount;
+}
+
+
+std::size_t Resampler::process (const sf::Int16* samples, std::size_t samplesCount, sf::Int16* output)
+{
+    if (passthrough ())
+    {
+        std::copy (samples, samples + samplesCount, output);
+        return samplesCount;
+    }
+
+    std::size_t framesCount = samplesCount / channelCount;
+
+    for (unsigned int channel = 0 ; channel != channelCount ; channel++)
+    {
+        std::vector<float>& channelHistory = history[channel];
+        std::size_t start = channelHistory.size ();
+
+        channelHistory.resize (start + framesCount);
+
+        for (std::size_t frame = 0 ; frame != framesCount ; frame++)
+            channelHistory[start + frame] = samples[frame * channelCount + channel];
+    }
+
+    inputFrames += framesCount;
+
+    return produce (output, ~std::size_t (0));
+}
+
+std::size_t Resampler::flush (sf::Int16* output)
+{
+    if (passthrough ())
+        return 0;
+
+    unsigned long long int expectedFrames = (inputFrames * upFactor + downFactor - 1) / downFactor;
+
+    for (std::vector<float>& channelHistory : history)  // The last input samples reach the filter center
+        channelHistory.resize (channelHistory.size () + taps, 0);
+
+    std::size_t outputSamples = produce (output, expectedFrames > outputFrames ? expectedFrames - outputFrames : 0);
+
+    reset ();
+
+    return outputSamples;
+}
+
+
+std::size_t Resampler::produce (sf::Int16* output, std::size_t maxFrames)  // Every output instant whose filter window is complete
+{
+    std::size_t available = history[0].size ();
+    std::size_t frames = 0;
+
+    DotFunction dot = selectedImplementation.function;
+
+    while (frames != maxFrames && position / upFactor + taps <= available)
+    {
+        std::size_t first = position / upFactor;
+        const float* phaseCoefficients = &coefficients[(position % upFactor) * taps];
+
+        for (unsigned int channel = 0 ; channel != channelCount ; channel++)
+        {
+            float value = std::round (dot (&history[channel][first], phaseCoefficients, taps));
+
+            output[frames * channelCount + channel] = sf::Int16 (std::max (-32768.0f, std::min (32767.0f, value)));
+        }
+
+        position += downFactor;
+        frames++;
+    }
+
+    outputFrames += frames;
+
+
+    std::size_t consumed = std::min<std::size_t> (position / upFactor, available);  // Keep only what the next windows need
+
+    for (std::vector<float>& channelHistory : history)
+        channelHistory.erase (channelHistory.begin (), channelHistory.begin () + consumed);
+
+    position -= (unsigned long long int) consumed * upFactor;
+
+    return frames * channelCount;
+}
+
+
+////////////////////////////////////////  Others
+
+
+void Resampler::setDefaultQuality (Quality quality)  // Used by the writers that have to resample on their own
+{
+    defaultQualitySetting = quality;
+}
+
+Resampler::Quality Resampler::defaultQuality ()
+{
+    return Quality (defaultQualitySetting.load ());
+}
+
+const char* Resampler::implementation ()
+{
+    return selectedImplementation.name;
+}
@@ -0,0 +1,58 @@
+#ifndef RESAMPLER_H
+#define RESAMPLER_H
+
+
+#include <SFML/Audio.hpp>
+
+#include <vector>
+
+
+// Streaming sample rate converter : polyphase windowed sinc (Kaiser), one filter phase per output instant of the reduced rates ratio
+// Only the filter length of history is kept per channel, blocks of any size can be given one after another
+
+class Resampler
+{
+    public:
+        enum Quality
+        {
+            Fast,
+            Balanced,
+            Best
+        };
+
+
+        Resampler ();
+
+        bool setup (unsigned int, unsigned int, unsigned int, Quality);  // Input rate, output rate and channels, false if the ratio is too complex
+        void reset ();
+
+        bool passthrough () const;
+        std::size_t maxOutputSamples (std::size_t) const;
+
+        std::size_t process (const sf::Int16*, std::size_t, sf::Int16*);  // Returns the count of output samples
+        std::size_t flush (sf::Int16*);  // Last output samples, the same count as the input is expected in the end
+
+        static void setDefaultQuality (Quality);
+        static Quality defaultQuality ();
+        static const char* implementation ();  // Name of the code path selected for this CPU
+
+
+    private:
+        std::size_t produce (sf::Int16*, std::size_t);
+
+
+        unsigned int channelCount;
+        unsigned int upFactor;
+        unsigned int downFactor;
+        unsigned int taps;  // Per phase, multiple of 8
+
+        std::vector<float> coefficients;  // One row of taps per phase, reversed so the history is read forward
+        std::vector<std::vector<float>> history;  // Per channel, input converted to float
+
+        unsigned long long int position;  // Next output instant, in input samples divided by upFactor, from the start of history
+        unsigned long long int inputFrames;
+        unsigned long long int outputFrames;
+};
+
+
+#endif // RESAMPLER_H
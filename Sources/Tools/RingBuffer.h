@@ -0,0 +1,118 @@
+#ifndef RINGBUFFER_H
+#define RINGBUFFER_H
+
+
+#include <atomic>
+#include <vector>
+#include <algorithm>
+
+
+// Single producer / single consumer lock-free FIFO, one thread may push while another one pops without any lock
+
+template <typename T>
+class RingBuffer
+{
+    public:
+        RingBuffer () : mask (0), head (0), tail (0), _highWaterMark (0), _overruns (0) { }
+
+
+        void allocate (std::size_t minimumCapacity)  // Not thread safe, call it before starting producer and consumer
+        {
+            std::size_t capacity = 1;
+
+            while (capacity < minimumCapacity)
+                capacity <<= 1;
+
+            buffer.assign (capacity, T ());
+            mask = capacity - 1;
+
+            clear ();
+        }
+
+        void clear ()  // Not thread safe either
+        {
+            head.store (0);
+            tail.store (0);
+
+            _highWaterMark.store (0);
+            _overruns.store (0);
+        }
+
+
+        bool push (const T* data, std::size_t count)  // Producer side, pushes the whole block or nothing
+        {
+            std::size_t writeIndex = head.load (std::memory_order_relaxed);
+            std::size_t used = writeIndex - tail.load (std::memory_order_acquire);
+
+            if (count > buffer.size () - used)
+            {
+                _overruns.fetch_add (1, std::memory_order_relaxed);
+                return false;
+            }
+
+            std::size_t start = writeIndex & mask;
+            std::size_t firstPart = std::min (count, buffer.size () - start);
+
+            std::copy (data, data + firstPart, buffer.begin () + start);
+            std::copy (data + firstPart, data + count, buffer.begin ());
+
+            head.store (writeIndex + count, std::memory_order_release);
+
+
+            if (used + count > _highWaterMark.load (std::memory_order_relaxed))
+                _highWaterMark.store (used + count, std::memory_order_relaxed);
+
+            return true;
+        }
+
+        std::size_t pop (T* data, std::size_t maxCount)  // Consumer side, returns the number of items read
+        {
+            std::size_t readIndex = tail.load (std::memory_order_relaxed);
+            std::size_t count = std::min (maxCount, head.load (std::memory_order_acquire) - readIndex);
+
+            std::size_t start = readIndex & mask;
+            std::size_t firstPart = std::min (count, buffer.size () - start);
+
+            std::copy (buffer.begin () + start, buffer.begin () + start + firstPart, data);
+            std::copy (buffer.begin (), buffer.begin () + (count - firstPart), data + firstPart);
+
+            tail.store (readIndex + count, std::memory_order_release);
+
+            return count;
+        }
+
+
+        std::size_t available () const
+        {
+            return head.load (std::memory_order_acquire) - tail.load (std::memory_order_acquire);
+        }
+
+        std::size_t capacity () const
+        {
+            return buffer.size ();
+        }
+
+        std::size_t highWaterMark () const
+        {
+            return _highWaterMark.load (std::memory_order_relaxed);
+        }
+
+        unsigned int overruns () const
+        {
+            return _overruns.load (std::memory_order_relaxed);
+        }
+
+
+    private:
+        std::vector<T> buffer;
+        std::size_t mask;
+
+        std::atomic<std::size_t> head;
+        std::atomic<std::size_t> tail;
+
+        std::atomic<std::size_t> _highWaterMark;
+        std::atomic<unsigned int> _overruns;
+};
+
+
+#endif // RINGBUFFER_H
@@ -0,0 +1,203 @@
+#include <algorithm>
+#include <chrono>
+
+#include "SampleStore.h"
+
+
+static const std::size_t preallocatedChunks = 4;
+static const std::size_t maxBatchChunks = 8;
+static const std::chrono::milliseconds maxBatchDelay (1000);  // A partial batch is written anyway after this time
+
+
+SampleStore::SampleStore ()
+{
+    currentChunk = nullptr;
+
+    chunkSamples = 0;
+    maxChunks = 0;
+    usedChunks = 0;
+
+    pendingSilence = 0;
+    dropping = false;
+    closed = false;
+
+    _storedBytes = 0;
+    _peakBytes = 0;
+    _droppedSamples = 0;
+    _dropEvents = 0;
+}
+
+
+void SampleStore::allocate (unsigned long long int budget, std::size_t samplesPerChunk)  // Budget in bytes, at least two chunks
+{
+    chunkSamples = samplesPerChunk;
+    maxChunks = std::max<unsigned long long int> (2, budget / (chunkSamples * sizeof (sf::Int16)));
+
+    pool.clear ();
+    freeChunks.clear ();
+    fullChunks.clear ();
+    currentChunk = nullptr;
+
+    for (std::size_t i = 0 ; i != std::min (maxChunks, preallocatedChunks) ; i++)
+    {
+        pool.emplace_back (new Chunk {std::vector<sf::Int16> (chunkSamples), 0, 0});
+        freeChunks.push_back (pool.back ().get ());
+    }
+
+    usedChunks = 0;
+    pendingSilence = 0;
+    dropping = false;
+    closed = false;
+
+    _storedBytes = 0;
+    _peakBytes = 0;
+    _droppedSamples = 0;
+    _dropEvents = 0;
+}
+
+void SampleStore::close ()  // The last chunk, even partial, goes with the next batch
+{
+    {
+        std::lock_guard<std::mutex> lock (mutex);
+        closed = true;
+    }
+
+    batchReady.notify_all ();
+}
+
+
+void SampleStore::push (const sf::Int16* samples, std::size_t samplesCount)  // Producer side, never waits for the disk
+{
+    std::unique_lock<std::mutex> lock (mutex);
+
+    while (samplesCount != 0)
+    {
+        if (!currentChunk)
+        {
+            currentChunk = freeChunk ();
+
+            if (!currentChunk)  // Budget exhausted
+            {
+                if (!dropping)
+                    _dropEvents++;
+
+                dropping = true;
+                pendingSilence += samplesCount;
+                _droppedSamples += samplesCount;
+
+                return;
+            }
+
+            currentChunk->silenceBefore = pendingSilence;
+            pendingSilence = 0;
+            dropping = false;
+        }
+
+        std::size_t copiedSamples = std::min (samplesCount, chunkSamples - currentChunk->used);
+
+        std::copy (samples, samples + copiedSamples, currentChunk->samples.begin () + currentChunk->used);
+
+        currentChunk->used += copiedSamples;
+        samples += copiedSamples;
+        samplesCount -= copiedSamples;
+
+        if (currentChunk->used == chunkSamples)
+        {
+            fullChunks.push_back (currentChunk);
+            currentChunk = nullptr;
+
+            if (fullChunks.size () >= std::min (maxBatchChunks, std::max<std::size_t> (1, maxChunks / 2)))
+                batchReady.notify_one ();
+        }
+    }
+}
+
+bool SampleStore::takeBatch (std::vector<Chunk*>& batch)  // Consumer side, waits for enough full chunks, false once closed and empty
+{
+    std::unique_lock<std::mutex> lock (mutex);
+
+    batchReady.wait_for (lock, maxBatchDelay, [this] () { return closed || fullChunks.size () >= std::min (maxBatchChunks, std::max<std::size_t> (1, maxChunks / 2)); });
+
+    batch.insert (batch.end (), fullChunks.begin (), fullChunks.end ());
+    fullChunks.clear ();
+
+    if (closed && currentChunk)
+    {
+        batch.push_back (currentChunk);
+        currentChunk = nullptr;
+    }
+
+    return !closed || !batch.empty ();
+}
+
+void SampleStore::recycle (std::vector<Chunk*>& batch)  // Chunks written to disk go back to the pool
+{
+    std::lock_guard<std::mutex> lock (mutex);
+
+    for (Chunk* chunk : batch)
+    {
+        chunk->used = 0;
+        chunk->silenceBefore = 0;
+
+        freeChunks.push_back (chunk);
+    }
+
+    usedChunks -= batch.size ();
+    _storedBytes = usedChunks * chunkSamples * sizeof (sf::Int16);
+
+    batch.clear ();
+}
+
+
+unsigned long long int SampleStore::trailingSilence ()  // Samples dropped after the last chunk
+{
+    std::lock_guard<std::mutex> lock (mutex);
+
+    return pendingSilence;
+}
+
+
+SampleStore::Chunk* SampleStore::freeChunk ()  // Called locked, the pool only grows up to the budget
+{
+    Chunk* chunk = nullptr;
+
+    if (!freeChunks.empty ())
+    {
+        chunk = freeChunks.back ();
+        freeChunks.pop_back ();
+    }
+    else if (pool.size () < maxChunks)
+    {
+        pool.emplace_back (new Chunk {std::vector<sf::Int16> (chunkSamples), 0, 0});
+        chunk = pool.back ().get ();
+    }
+    else
+        return nullptr;
+
+    usedChunks++;
+    _storedBytes = usedChunks * chunkSamples * sizeof (sf::Int16);
+    _peakBytes = std::max (_peakBytes.load (), _storedBytes.load ());
+
+    return chunk;
+}
+
+
+unsigned long long int SampleStore::storedBytes () const  // Memory holding audio not written yet, safe from any thread
+{
+    return _storedBytes;
+}
+
+unsigned long long int SampleStore::peakBytes () const
+{
+    return _peakBytes;
+}
+
+unsigned long long int SampleStore::droppedSamples () const
+{
+    return _droppedSamples;
+}
+
+unsigned int SampleStore::dropEvents () const
+{
+    return _dropEvents;
+}
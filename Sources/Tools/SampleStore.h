@@ -0,0 +1,72 @@
+#ifndef SAMPLESTORE_H
+#define SAMPLESTORE_H
+
+
+#include <SFML/Audio.hpp>
+
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <vector>
+
+
+// Memory first recording : samples are kept in a pool of large chunks bounded by a budget, and handed over to the disk by batches
+// When the budget is exhausted the newest audio is dropped, never blocking, and replaced by as much silence once the disk caught up
+
+class SampleStore
+{
+    public:
+        struct Chunk
+        {
+            std::vector<sf::Int16> samples;
+            std::size_t used;
+            unsigned long long int silenceBefore;  // Samples dropped just before this chunk
+        };
+
+
+        SampleStore ();
+
+        void allocate (unsigned long long int, std::size_t);  // Not thread safe, call it before using the store
+        void close ();
+
+        void push (const sf::Int16*, std::size_t);
+        bool takeBatch (std::vector<Chunk*>&);
+        void recycle (std::vector<Chunk*>&);
+        unsigned long long int trailingSilence ();
+
+        unsigned long long int storedBytes () const;
+        unsigned long long int peakBytes () const;
+        unsigned long long int droppedSamples () const;
+        unsigned int dropEvents () const;
+
+
+    private:
+        Chunk* freeChunk ();
+
+
+        std::mutex mutex;
+        std::condition_variable batchReady;
+
+        std::vector<std::unique_ptr<Chunk>> pool;
+        std::vector<Chunk*> freeChunks;
+        std::deque<Chunk*> fullChunks;
+        Chunk* currentChunk;
+
+        std::size_t chunkSamples;
+        std::size_t maxChunks;
+        std::size_t usedChunks;
+
+        unsigned long long int pendingSilence;
+        bool dropping;
+        bool closed;
+
+        std::atomic<unsigned long long int> _storedBytes;
+        std::atomic<unsigned long long int> _peakBytes;
+        std::atomic<unsigned long long int> _droppedSamples;
+        std::atomic<unsigned int> _dropEvents;
+};
+
+
+#endif // SAMPLESTORE_H
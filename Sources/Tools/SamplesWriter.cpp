@@ -0,0 +1,455 @@
+#include <QFileInfo>
+#include <QFile>
+
+#include "SamplesWriter.h"
+#include "SoundFileWriters.h"
+
+
+static const std::size_t storeChunkSamples = 1 << 17;  // 256 KiB chunks
+
+
+////////////////////////////////////////  Constructor / Destructor
+
+
+SamplesWriter::SamplesWriter () : QThread ()
+{
+    _sampleRate = 44100;
+    _channelCount = 2;
+    _bufferDuration = 2000;
+
+    segmentDuration = 0;
+    segmentFrames = 0;
+    segmentBytes = 0;
+    segmentFramesWritten = 0;
+
+    memoryBudget = 0;
+    inputRate = 0;
+
+    stopRequested = false;
+}
+
+SamplesWriter::~SamplesWriter ()
+{
+    finish ();
+}
+
+
+////////////////////////////////////////  Controls
+
+
+bool SamplesWriter::open (const std::string& fileName, unsigned int sampleRate, unsigned int channelCount)
+{
+    return open (fileName, sampleRate, std::vector<unsigned int> ({channelCount}));
+}
+
+bool SamplesWriter::open (const std::string& fileName, unsigned int sampleRate, const std::vector<unsigned int>& channelCounts)
+{
+    _sampleRate = sampleRate;
+    _channelCount = 0;
+
+    inputsChannelCounts = channelCounts;
+
+    rings.clear ();
+
+    for (unsigned short int i = 0 ; i != inputsChannelCounts.size () ; i++)
+    {
+        _channelCount += inputsChannelCounts.at (i);
+        rings.emplace_back (new RingBuffer<sf::Int16>);
+    }
+
+    baseFileName = fileName;
+    segmentFiles.assign (1, fileName);
+    segmentFramesWritten = 0;
+
+    outputStream = SoundFileWriters::open (fileName, sampleRate, _channelCount);
+    peaks.begin (sampleRate, _channelCount);
+
+    return outputStream != nullptr;
+}
+
+
+void SamplesWriter::begin ()  // Allocate the rings for the current format, must be called before the capture threads start
+{
+    unsigned int captureRate = inputRate != 0 ? inputRate : _sampleRate;
+    unsigned int chunkFrames = captureRate / 10;
+
+    inputBuffers.resize (rings.size ());
+
+    for (unsigned short int i = 0 ; i != rings.size () ; i++)
+    {
+        rings.at (i)->allocate (std::size_t (captureRate) * inputsChannelCounts.at (i) * _bufferDuration / 1000);
+        inputBuffers.at (i).resize (chunkFrames * inputsChannelCounts.at (i));
+    }
+
+    drainBuffer.resize (chunkFrames * _channelCount);
+
+    if (!resampler.setup (captureRate, _sampleRate, _channelCount, Resampler::defaultQuality ()))  // Rates too far from a simple ratio are written as they are
+    {
+        _sampleRate = captureRate;  // The header must say so, nothing was written yet
+
+        outputStream.reset ();
+        outputStream = SoundFileWriters::open (baseFileName, _sampleRate, _channelCount);
+        peaks.begin (_sampleRate, _channelCount);
+
+        resampler.setup (_sampleRate, _sampleRate, _channelCount, Resampler::defaultQuality ());
+    }
+
+    resampledBuffer.resize (resampler.maxOutputSamples (drainBuffer.size ()));
+
+    segmentFrames = (unsigned long long int) segmentDuration * _sampleRate;
+
+    if (segmentFrames != 0 || segmentBytes != 0)
+        prepareNextSegment ();
+
+    if (memoryBudget != 0)
+    {
+        memoryStore.allocate ((unsigned long long int) memoryBudget * 1024 * 1024, storeChunkSamples / _channelCount * _channelCount);
+        silenceBuffer.assign (chunkFrames * _channelCount, 0);
+
+        spiller = std::thread (&SamplesWriter::spill, this);
+    }
+
+    stopRequested = false;
+    start (QThread::HighPriority);
+}
+
+void SamplesWriter::finish ()  // Write the remaining samples and close the file
+{
+    if (isRunning ())
+    {
+        stopRequested = true;
+        wait ();
+    }
+
+    discardNextSegment ();
+
+    if (closingSegment.valid ())
+        closingSegment.wait ();
+
+    if (outputStream)
+    {
+        outputStream.reset ();
+        peaks.save (QString::fromLocal8Bit (segmentFiles.back ().c_str ()));
+    }
+}
+
+
+bool SamplesWriter::write (const sf::Int16* samples, std::size_t samplesCount, unsigned short int input)  // Called from a capture thread, never blocks
+{
+    return rings.at (input)->push (samples, samplesCount);
+}
+
+
+void SamplesWriter::run ()
+{
+    while (!stopRequested)
+    {
+        if (rings.at (0)->available () < inputBuffers.at (0).size ())
+            msleep (5);
+
+        drain (false);
+    }
+
+    drain (true);
+    store (&resampledBuffer[0], resampler.flush (&resampledBuffer[0]));
+
+    if (spiller.joinable ())  // Wait for the disk to get everything stored in memory
+    {
+        memoryStore.close ();
+        spiller.join ();
+    }
+}
+
+void SamplesWriter::drain (bool lastCall)
+{
+    if (rings.size () != 1)
+    {
+        drainInterleaved (lastCall);
+        return;
+    }
+
+
+    std::size_t readSamples = rings.at (0)->pop (&drainBuffer[0], drainBuffer.size ());
+
+    while (readSamples != 0)
+    {
+        output (&drainBuffer[0], readSamples);
+
+        readSamples = rings.at (0)->pop (&drainBuffer[0], drainBuffer.size ());
+    }
+}
+
+void SamplesWriter::drainInterleaved (bool lastCall)  // Write as many frames as all inputs have, on the last call the shorter inputs are padded with silence
+{
+    std::size_t chunkFrames = drainBuffer.size () / _channelCount;
+
+    while (true)
+    {
+        std::size_t framesCount = lastCall ? 0 : chunkFrames;
+
+        for (unsigned short int i = 0 ; i != rings.size () ; i++)
+        {
+            std::size_t inputFrames = rings.at (i)->available () / inputsChannelCounts.at (i);
+
+            framesCount = lastCall ? std::max (framesCount, inputFrames) : std::min (framesCount, inputFrames);
+        }
+
+        framesCount = std::min (framesCount, chunkFrames);
+
+        if (framesCount == 0)
+            return;
+
+
+        unsigned int firstChannel = 0;
+
+        for (unsigned short int i = 0 ; i != rings.size () ; i++)
+        {
+            unsigned int inputChannels = inputsChannelCounts.at (i);
+            std::vector<sf::Int16>& inputBuffer = inputBuffers.at (i);
+
+            std::size_t readSamples = rings.at (i)->pop (&inputBuffer[0], framesCount * inputChannels);
+            std::fill (inputBuffer.begin () + readSamples, inputBuffer.begin () + framesCount * inputChannels, 0);
+
+            for (std::size_t frame = 0 ; frame != framesCount ; frame++)
+                for (unsigned int channel = 0 ; channel != inputChannels ; channel++)
+                    drainBuffer[frame * _channelCount + firstChannel + channel] = inputBuffer[frame * inputChannels + channel];
+
+            firstChannel += inputChannels;
+        }
+
+        output (&drainBuffer[0], framesCount * _channelCount);
+    }
+}
+
+void SamplesWriter::output (const sf::Int16* samples, std::size_t samplesCount)
+{
+    if (resampler.passthrough ())
+        store (samples, samplesCount);
+    else
+        store (&resampledBuffer[0], resampler.process (samples, samplesCount, &resampledBuffer[0]));
+}
+
+void SamplesWriter::store (const sf::Int16* samples, std::size_t samplesCount)  // In memory first if a budget is set, directly in the file otherwise
+{
+    if (spiller.joinable ())
+        memoryStore.push (samples, samplesCount);
+    else
+        writeFrames (samples, samplesCount);
+}
+
+void SamplesWriter::spill ()  // Thread writing the memory store to disk, batch after batch
+{
+    std::vector<SampleStore::Chunk*> batch;
+
+    while (memoryStore.takeBatch (batch))
+    {
+        for (SampleStore::Chunk* chunk : batch)
+        {
+            writeSilence (chunk->silenceBefore);  // Dropped audio keeps its place in the timeline
+            writeFrames (&chunk->samples[0], chunk->used);
+        }
+
+        memoryStore.recycle (batch);
+    }
+
+    writeSilence (memoryStore.trailingSilence ());
+}
+
+void SamplesWriter::writeSilence (unsigned long long int samplesCount)
+{
+    while (samplesCount != 0)
+    {
+        std::size_t silenceSamples = std::min<unsigned long long int> (samplesCount, silenceBuffer.size ());
+
+        writeFrames (&silenceBuffer[0], silenceSamples);
+        samplesCount -= silenceSamples;
+    }
+}
+
+
+////////////////////////////////////////  Segments
+
+
+void SamplesWriter::writeFrames (const sf::Int16* samples, std::size_t samplesCount)  // A segment ends exactly on its frames limit, the rest goes to the next one
+{
+    if (!outputStream)  // Could not be opened again at the capture rate
+        return;
+
+    while (samplesCount != 0)
+    {
+        std::size_t writtenSamples = samplesCount;
+
+        if (segmentFrames != 0)
+            writtenSamples = std::min<unsigned long long int> (samplesCount, (segmentFrames - segmentFramesWritten) * _channelCount);
+
+        outputStream->write (samples, writtenSamples);
+        peaks.add (samples, writtenSamples);
+
+        segmentFramesWritten += writtenSamples / _channelCount;
+        samples += writtenSamples;
+        samplesCount -= writtenSamples;
+
+        if (segmentFull ())
+            rotate ();
+    }
+}
+
+bool SamplesWriter::segmentFull ()
+{
+    if (!nextSegment.valid ())  // No rotation wanted, or the next file could not be opened
+        return false;
+
+    if (segmentFrames != 0 && segmentFramesWritten >= segmentFrames)
+        return true;
+
+    // The size is only checked between chunks, so a segment may go a little above it
+    return segmentBytes != 0 && (unsigned long long int) QFileInfo (QString::fromLocal8Bit (segmentFiles.back ().c_str ())).size () >= segmentBytes;
+}
+
+void SamplesWriter::rotate ()  // Switch to the segment opened in advance, the full one is finalized on a helper thread
+{
+    std::unique_ptr<sf::SoundFileWriter> newStream = nextSegment.get ();
+
+    if (!newStream)  // Disk full or not writable : the rest goes to the current file, without limit, rather than nowhere
+    {
+        segmentFrames = 0;
+        return;
+    }
+
+    if (closingSegment.valid ())
+        closingSegment.wait ();
+
+    std::shared_ptr<sf::SoundFileWriter> fullStream (std::move (outputStream));
+    std::shared_ptr<PeakBuilder> fullPeaks (new PeakBuilder (std::move (peaks)));
+    QString fullFileName = QString::fromLocal8Bit (segmentFiles.back ().c_str ());
+
+    closingSegment = std::async (std::launch::async, [this, fullStream, fullPeaks, fullFileName] () mutable
+    {
+        fullStream.reset ();
+        fullPeaks->save (fullFileName);
+
+        emit segmentCompleted (fullFileName);
+    });
+
+    outputStream = std::move (newStream);
+    peaks.begin (_sampleRate, _channelCount);
+    segmentFiles.push_back (segmentFileName (segmentFiles.size () + 1));
+    segmentFramesWritten = 0;
+
+    prepareNextSegment ();
+}
+
+void SamplesWriter::prepareNextSegment ()
+{
+    nextSegment = std::async (std::launch::async, SoundFileWriters::open, segmentFileName (segmentFiles.size () + 1), _sampleRate, _channelCount);
+}
+
+void SamplesWriter::discardNextSegment ()  // The file opened in advance was not used, remove it
+{
+    if (!nextSegment.valid ())
+        return;
+
+    std::unique_ptr<sf::SoundFileWriter> unusedStream = nextSegment.get ();
+
+    if (!unusedStream)
+        return;
+
+    unusedStream.reset ();
+    QFile::remove (QString::fromLocal8Bit (segmentFileName (segmentFiles.size () + 1).c_str ()));
+}
+
+std::string SamplesWriter::segmentFileName (unsigned int number)  // "Take.ogg", then "Take (part 2).ogg"...
+{
+    if (number == 1)
+        return baseFileName;
+
+    std::size_t extensionIndex = baseFileName.find_last_of ('.');
+    std::string part = " (part " + std::to_string (number) + ")";
+
+    if (extensionIndex == std::string::npos || baseFileName.find_first_of ("/\\", extensionIndex) != std::string::npos)
+        return baseFileName + part;
+
+    return baseFileName.substr (0, extensionIndex) + part + baseFileName.substr (extensionIndex);
+}
+
+
+////////////////////////////////////////  Others
+
+
+void SamplesWriter::setBufferDuration (unsigned int milliseconds)
+{
+    _bufferDuration = milliseconds;
+}
+
+unsigned int SamplesWriter::bufferDuration ()
+{
+    return _bufferDuration;
+}
+
+void SamplesWriter::setSegmentLimits (unsigned int seconds, unsigned long long int bytes)  // Start a new file after this duration or size, 0 for no limit, must be set before begin
+{
+    segmentDuration = seconds;
+    segmentBytes = bytes;
+}
+
+void SamplesWriter::setMemoryBudget (unsigned int megabytes)  // RAM kept for audio waiting for the disk, 0 to write directly, must be set before begin
+{
+    memoryBudget = megabytes;
+}
+
+void SamplesWriter::setInputRate (unsigned int sampleRate)  // Rate of the captured samples, 0 for the file rate, must be set before begin
+{
+    inputRate = sampleRate;
+}
+
+const std::vector<std::string>& SamplesWriter::files ()  // Every segment written, only reliable once finished
+{
+    return segmentFiles;
+}
+
+
+std::size_t SamplesWriter::highWaterMark ()
+{
+    std::size_t highest = 0;
+
+    for (unsigned short int i = 0 ; i != rings.size () ; i++)
+        highest = std::max (highest, rings.at (i)->highWaterMark ());
+
+    return highest;
+}
+
+std::size_t SamplesWriter::capacity ()
+{
+    return rings.empty () ? 0 : rings.at (0)->capacity ();
+}
+
+unsigned int SamplesWriter::overruns ()
+{
+    unsigned int total = 0;
+
+    for (unsigned short int i = 0 ; i != rings.size () ; i++)
+        total += rings.at (i)->overruns ();
+
+    return total;
+}
+
+
+unsigned long long int SamplesWriter::memoryUsed ()
+{
+    return memoryBudget != 0 ? memoryStore.storedBytes () : 0;
+}
+
+unsigned long long int SamplesWriter::memoryPeak ()
+{
+    return memoryBudget != 0 ? memoryStore.peakBytes () : 0;
+}
+
+unsigned long long int SamplesWriter::droppedFrames ()  // Lost because the memory budget was exhausted, written back as silence
+{
+    return memoryBudget != 0 ? memoryStore.droppedSamples () / _channelCount : 0;
+}
+
+unsigned int SamplesWriter::dropEvents ()  // Times the budget ran out, each one a hole of silence in the file
+{
+    return memoryBudget != 0 ? memoryStore.dropEvents () : 0;
+}
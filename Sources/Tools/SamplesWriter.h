@@ -0,0 +1,117 @@
+#ifndef SAMPLESWRITER_H
+#define SAMPLESWRITER_H
+
+
+#include <QThread>
+
+#include <SFML/Audio.hpp>
+
+#include <memory>
+#include <future>
+#include <thread>
+
+#include "RingBuffer.h"
+#include "SampleStore.h"
+#include "Resampler.h"
+#include "PeakFile.h"
+
+
+// Encoder thread : the capture callbacks only copy samples into ring buffers, this thread drains them into the output file
+// With several inputs, their channels are interleaved frame by frame into one multichannel file
+// Long recordings can be split in segments, the next one is opened in advance so the switch loses no sample
+// Inputs captured at another rate than the file are resampled here, off the capture threads
+// With a memory budget, drained samples are stored in RAM first and written by large batches from another thread, for slow disks
+// The waveform overview of every file is built from the samples written to it, and saved when it is closed
+
+class SamplesWriter : public QThread
+{
+    Q_OBJECT
+
+    public:
+        SamplesWriter ();
+        virtual ~SamplesWriter ();
+
+        bool open (const std::string&, unsigned int, unsigned int);
+        bool open (const std::string&, unsigned int, const std::vector<unsigned int>&);
+
+        void setBufferDuration (unsigned int);
+        unsigned int bufferDuration ();
+
+        void setSegmentLimits (unsigned int, unsigned long long int);
+        void setMemoryBudget (unsigned int);
+        void setInputRate (unsigned int);
+        const std::vector<std::string>& files ();
+
+        void begin ();
+        void finish ();
+
+        bool write (const sf::Int16*, std::size_t, unsigned short int = 0);
+
+        std::size_t highWaterMark ();
+        std::size_t capacity ();
+        unsigned int overruns ();
+
+        unsigned long long int memoryUsed ();
+        unsigned long long int memoryPeak ();
+        unsigned long long int droppedFrames ();
+        unsigned int dropEvents ();
+
+
+    signals:
+        void segmentCompleted (const QString&);
+
+
+    private:
+        virtual void run () override;
+
+        void drain (bool);
+        void drainInterleaved (bool);
+        void output (const sf::Int16*, std::size_t);
+        void store (const sf::Int16*, std::size_t);
+        void spill ();
+        void writeSilence (unsigned long long int);
+
+        void writeFrames (const sf::Int16*, std::size_t);
+        bool segmentFull ();
+        void rotate ();
+        void prepareNextSegment ();
+        void discardNextSegment ();
+        std::string segmentFileName (unsigned int);
+
+
+        unsigned int _sampleRate;
+        unsigned int _channelCount;
+        unsigned int _bufferDuration;
+
+        std::atomic<bool> stopRequested;
+
+        std::vector<unsigned int> inputsChannelCounts;
+        std::vector<std::unique_ptr<RingBuffer<sf::Int16>>> rings;
+        std::vector<std::vector<sf::Int16>> inputBuffers;
+        std::vector<sf::Int16> drainBuffer;
+
+        unsigned int inputRate;  // 0 when the inputs are captured at the file rate
+        Resampler resampler;
+        std::vector<sf::Int16> resampledBuffer;
+
+        unsigned int memoryBudget;  // In megabytes, 0 to write directly
+        SampleStore memoryStore;
+        std::thread spiller;
+        std::vector<sf::Int16> silenceBuffer;
+
+        std::unique_ptr<sf::SoundFileWriter> outputStream;
+        PeakBuilder peaks;
+
+        unsigned int segmentDuration;
+        unsigned long long int segmentFrames;  // 0 for no limit
+        unsigned long long int segmentBytes;
+        unsigned long long int segmentFramesWritten;
+
+        std::string baseFileName;
+        std::vector<std::string> segmentFiles;
+        std::future<std::unique_ptr<sf::SoundFileWriter>> nextSegment;
+        std::future<void> closingSegment;
+};
+
+
+#endif // SAMPLESWRITER_H
@@ -0,0 +1,388 @@
+#include <QFileInfo>
+#include <QSaveFile>
+
+#include <cstring>
+#include <algorithm>
+
+#include "SeekIndex.h"
+#include "CacheFiles.h"
+
+
+static const std::uint32_t formatVersion = 1;
+static const std::size_t maxFlacHeaderSize = 16;
+
+struct SeekIndexHeader  // Followed by the points, in file order
+{
+    char magic[4];
+    std::uint32_t version;
+    std::uint64_t pointsCount;
+    std::uint64_t audioSize;  // Recording the index was built from
+    std::int64_t audioModified;
+};
+
+
+static bool validHeader (const SeekIndexHeader& header, const QString& recording)
+{
+    return std::memcmp (header.magic, "MRSK", 4) == 0 && header.version == formatVersion &&
+           CacheFiles::matches (recording, header.audioSize, header.audioModified);
+}
+
+static std::uint64_t littleEndian (const unsigned char* bytes, unsigned short int count)
+{
+    std::uint64_t value = 0;
+
+    for (unsigned short int i = count ; i != 0 ; i--)
+        value = (value << 8) | bytes[i - 1];
+
+    return value;
+}
+
+
+////////////////////////////////////////  FLAC frame headers
+
+
+static unsigned char crc8 (const unsigned char* bytes, std::size_t count)  // Polynomial x^8 + x^2 + x + 1, protects each frame header
+{
+    unsigned char crc = 0;
+
+    for (std::size_t i = 0 ; i != count ; i++)
+    {
+        crc ^= bytes[i];
+
+        for (unsigned short int bit = 0 ; bit != 8 ; bit++)
+            crc = (crc & 0x80) ? (crc << 1) ^ 0x07 : crc << 1;
+    }
+
+    return crc;
+}
+
+static bool parseFlacFrameHeader (const unsigned char* bytes, std::size_t available, unsigned long long int& number)  // Frame or sample number, depending on the blocking strategy
+{
+    if (available < 6 || bytes[0] != 0xFF || (bytes[1] & 0xFE) != 0xF8)
+        return false;
+
+    unsigned int blockSizeCode = bytes[2] >> 4;
+    unsigned int rateCode = bytes[2] & 0x0F;
+    unsigned int channelsCode = bytes[3] >> 4;
+    unsigned int sampleSizeCode = (bytes[3] >> 1) & 0x07;
+
+    if (blockSizeCode == 0 || rateCode == 15 || channelsCode > 10 || sampleSizeCode == 3 || (bytes[3] & 1) != 0)
+        return false;
+
+
+    unsigned int leadingOnes = 0;  // UTF-8 like coding, up to 36 bits
+
+    while (leadingOnes != 8 && (bytes[4] & (0x80 >> leadingOnes)) != 0)
+        leadingOnes++;
+
+    if (leadingOnes == 1 || leadingOnes == 8)
+        return false;
+
+    unsigned int extraBytes = leadingOnes == 0 ? 0 : leadingOnes - 1;
+    number = bytes[4] & (0x7F >> leadingOnes);
+
+    std::size_t size = 5;
+
+    if (available < size + extraBytes)
+        return false;
+
+    for (unsigned int i = 0 ; i != extraBytes ; i++, size++)
+    {
+        if ((bytes[size] & 0xC0) != 0x80)
+            return false;
+
+        number = (number << 6) | (bytes[size] & 0x3F);
+    }
+
+    size += blockSizeCode == 6 ? 1 : blockSizeCode == 7 ? 2 : 0;
+    size += rateCode == 12 ? 1 : (rateCode == 13 || rateCode == 14) ? 2 : 0;
+
+    return available > size && crc8 (bytes, size) == bytes[size];
+}
+
+
+////////////////////////////////////////  Reader
+
+
+SeekIndex::SeekIndex ()
+{
+    points = nullptr;
+    pointsCount = 0;
+}
+
+
+bool SeekIndex::open (const QString& recording)
+{
+    close ();
+
+    file.setFileName (CacheFiles::path (recording, "seek"));
+
+    if (!file.open (QIODevice::ReadOnly) || file.size () < qint64 (sizeof (SeekIndexHeader)))
+    {
+        close ();
+        return false;
+    }
+
+    const uchar* data = file.map (0, file.size ());
+    const SeekIndexHeader* header = reinterpret_cast<const SeekIndexHeader*> (data);
+
+    if (data == nullptr || !validHeader (*header, recording) ||
+        (unsigned long long int) file.size () != sizeof (SeekIndexHeader) + header->pointsCount * sizeof (SeekPoint))
+    {
+        close ();
+        return false;
+    }
+
+    points = reinterpret_cast<const SeekPoint*> (data + sizeof (SeekIndexHeader));
+    pointsCount = header->pointsCount;
+
+    return true;
+}
+
+void SeekIndex::close ()
+{
+    file.close ();
+
+    points = nullptr;
+    pointsCount = 0;
+}
+
+bool SeekIndex::isOpen () const
+{
+    return pointsCount != 0;
+}
+
+
+bool SeekIndex::find (unsigned long long int frame, SeekPoint& point, unsigned int earlier) const
+{
+    const SeekPoint* after = std::upper_bound (points, points + pointsCount, frame, [] (unsigned long long int value, const SeekPoint& candidate) { return value < candidate.frame; });
+
+    if (after == points)
+        return false;
+
+    point = *(after - 1 - std::min<std::size_t> (earlier, after - 1 - points));
+
+    return true;
+}
+
+
+bool SeekIndex::upToDate (const QString& recording)
+{
+    QFile sidecar (CacheFiles::path (recording, "seek"));
+    SeekIndexHeader header;
+
+    return sidecar.open (QIODevice::ReadOnly) && sidecar.read (reinterpret_cast<char*> (&header), sizeof (header)) == qint64 (sizeof (header)) &&
+           validHeader (header, recording);
+}
+
+bool SeekIndex::supported (const QString& recording)
+{
+    QString suffix = QFileInfo (recording).suffix ().toLower ();
+
+    return suffix == "ogg" || suffix == "flac";
+}
+
+
+////////////////////////////////////////  Builder
+
+
+SeekIndexBuilder::SeekIndexBuilder ()
+{
+    begin (44100);
+}
+
+
+void SeekIndexBuilder::begin (unsigned int sampleRate)
+{
+    spacing = std::max (1U, sampleRate / 4);
+    points.clear ();
+}
+
+void SeekIndexBuilder::add (unsigned long long int frame, unsigned long long int offset)
+{
+    if (points.empty () || frame >= points.back ().frame + spacing)
+        points.push_back ({frame, offset});
+}
+
+bool SeekIndexBuilder::save (const QString& recording)
+{
+    SeekIndexHeader header;
+    std::memcpy (header.magic, "MRSK", 4);
+    header.version = formatVersion;
+    header.pointsCount = points.size ();
+
+    unsigned long long int audioSize;
+    long long int audioModified;
+
+    CacheFiles::recordingState (recording, audioSize, audioModified);
+    header.audioSize = audioSize;
+    header.audioModified = audioModified;
+
+
+    QSaveFile file (CacheFiles::path (recording, "seek"));
+
+    if (audioModified == 0 || points.empty () || !file.open (QIODevice::WriteOnly))
+        return false;
+
+    file.write (reinterpret_cast<const char*> (&header), sizeof (header));
+    file.write (reinterpret_cast<const char*> (&points[0]), points.size () * sizeof (SeekPoint));
+
+    return file.commit ();
+}
+
+
+bool SeekIndexBuilder::scan (const QString& recording, const std::atomic<bool>& stopRequested)
+{
+    QFile input (recording);
+
+    if (!input.open (QIODevice::ReadOnly))
+        return false;
+
+    bool scanned = QFileInfo (recording).suffix ().toLower () == "flac" ? scanFlac (input, stopRequested) : scanOgg (input, stopRequested);
+    input.close ();
+
+    return scanned && save (recording);
+}
+
+bool SeekIndexBuilder::scanOgg (QFile& input, const std::atomic<bool>& stopRequested)  // Page headers only, a point per audio page of the first logical stream
+{
+    long long int previousGranule = -1;  // Last sample completed before the current page
+    std::uint64_t streamSerial = 0;
+
+    while (!stopRequested)
+    {
+        qint64 pageOffset = input.pos ();
+
+        unsigned char header[27];
+        qint64 readBytes = input.read (reinterpret_cast<char*> (header), sizeof (header));
+
+        if (readBytes == 0)
+            return !points.empty ();
+
+        unsigned char segments[255];
+
+        if (readBytes != sizeof (header) || std::memcmp (header, "OggS", 4) != 0 || input.read (reinterpret_cast<char*> (segments), header[26]) != header[26])
+            return false;
+
+        qint64 bodySize = 0;
+
+        for (unsigned short int i = 0 ; i != header[26] ; i++)
+            bodySize += segments[i];
+
+        long long int granule = (long long int) littleEndian (header + 6, 8);
+        std::uint64_t serial = littleEndian (header + 14, 4);
+
+
+        if (pageOffset == 0)  // Vorbis identification header, for the sample rate
+        {
+            QByteArray body = input.peek (bodySize);
+
+            if (body.size () < 16 || body.at (0) != 1 || body.mid (1, 6) != "vorbis")
+                return false;
+
+            streamSerial = serial;
+            begin (littleEndian (reinterpret_cast<const unsigned char*> (body.constData ()) + 12, 4));
+        }
+        else if (serial != streamSerial)  // Chained or multiplexed streams are left to the decoder
+            return false;
+
+        if (granule > 0)  // Audio page, at least one packet ends on it
+        {
+            if (previousGranule >= 0)
+                add (previousGranule, pageOffset);
+
+            previousGranule = granule;
+        }
+        else if (granule == 0)
+            previousGranule = 0;
+
+        if (!input.seek (pageOffset + sizeof (header) + header[26] + bodySize))
+            return false;
+    }
+
+    return false;
+}
+
+bool SeekIndexBuilder::scanFlac (QFile& input, const std::atomic<bool>& stopRequested)  // Looks for the frame headers, checked by their CRC and by following each other
+{
+    unsigned char signature[4];
+
+    if (input.read (reinterpret_cast<char*> (signature), 4) != 4 || std::memcmp (signature, "fLaC", 4) != 0)
+        return false;
+
+    unsigned int minBlockSize = 0;
+    bool lastBlock = false;
+
+    while (!lastBlock)
+    {
+        unsigned char blockHeader[4];
+
+        if (input.read (reinterpret_cast<char*> (blockHeader), 4) != 4)
+            return false;
+
+        lastBlock = (blockHeader[0] & 0x80) != 0;
+        qint64 length = (blockHeader[1] << 16) | (blockHeader[2] << 8) | blockHeader[3];
+
+        if ((blockHeader[0] & 0x7F) == 0)  // STREAMINFO
+        {
+            unsigned char info[18];
+
+            if (length < 34 || input.read (reinterpret_cast<char*> (info), sizeof (info)) != sizeof (info))
+                return false;
+
+            minBlockSize = (info[0] << 8) | info[1];
+            begin ((info[10] << 12) | (info[11] << 4) | (info[12] >> 4));
+
+            length -= sizeof (info);
+        }
+
+        if (!input.seek (input.pos () + length))
+            return false;
+    }
+
+    if (minBlockSize == 0)
+        return false;
+
+
+    std::vector<unsigned char> buffer;
+    unsigned long long int bufferOffset = input.pos ();
+
+    unsigned long long int lastFrame = 0;
+    bool frameFound = false;
+
+    while (!stopRequested)
+    {
+        QByteArray data = input.read (1 << 20);
+        buffer.insert (buffer.end (), data.constData (), data.constData () + data.size ());
+
+        bool atEnd = data.isEmpty ();
+        std::size_t limit = atEnd ? buffer.size () : (buffer.size () > maxFlacHeaderSize ? buffer.size () - maxFlacHeaderSize : 0);  // A header may continue in the next chunk
+        std::size_t i = 0;
+
+        for ( ; i < limit ; i++)
+        {
+            unsigned long long int number;
+
+            if (buffer[i] != 0xFF || !parseFlacFrameHeader (&buffer[i], buffer.size () - i, number))
+                continue;
+
+            unsigned long long int frame = (buffer[i + 1] & 1) ? number : number * minBlockSize;
+
+            if (frameFound ? (frame <= lastFrame || frame > lastFrame + 65535) : frame != 0)  // A sync code inside the audio data
+                continue;
+
+            add (frame, bufferOffset + i);
+
+            lastFrame = frame;
+            frameFound = true;
+        }
+
+        buffer.erase (buffer.begin (), buffer.begin () + i);
+        bufferOffset += i;
+
+        if (atEnd)
+            return frameFound;
+    }
+
+    return false;
+}
@@ -0,0 +1,69 @@
+#ifndef SEEKINDEX_H
+#define SEEKINDEX_H
+
+
+#include <QFile>
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+
+// Byte offsets of a compressed recording : from each point, decoding gives the frame it names at the latest,
+// so a seek reads from the last point before its target and only decodes the rest of the way
+
+struct SeekPoint
+{
+    std::uint64_t frame;
+    std::uint64_t offset;  // Of an Ogg page or a FLAC frame
+};
+
+
+class SeekIndex
+{
+    public:
+        SeekIndex ();
+
+        bool open (const QString&);  // The audio file, false if its index is missing or outdated
+        void close ();
+        bool isOpen () const;
+
+        bool find (unsigned long long int, SeekPoint&, unsigned int = 0) const;  // Last point at or before the frame, or that many points earlier
+
+        static bool upToDate (const QString&);
+        static bool supported (const QString&);  // Ogg and FLAC files
+
+
+    private:
+        QFile file;
+
+        const SeekPoint* points;
+        std::size_t pointsCount;
+};
+
+
+// Filled by the FLAC writer as frames reach the file, or by reading the page or frame headers of an existing file, without decoding
+
+class SeekIndexBuilder
+{
+    public:
+        SeekIndexBuilder ();
+
+        void begin (unsigned int);  // Sample rate, a point every quarter second at most
+        void add (unsigned long long int, unsigned long long int);  // Frame and offset, in file order
+        bool save (const QString&);  // Once the audio file is closed
+
+        bool scan (const QString&, const std::atomic<bool>&);  // Stops and fails when the flag is raised
+
+
+    private:
+        bool scanOgg (QFile&, const std::atomic<bool>&);
+        bool scanFlac (QFile&, const std::atomic<bool>&);
+
+
+        unsigned long long int spacing;
+        std::vector<SeekPoint> points;
+};
+
+
+#endif // SEEKINDEX_H
@@ -0,0 +1,60 @@
+#ifndef SEQLOCK_H
+#define SEQLOCK_H
+
+
+#include <atomic>
+#include <cstring>
+
+
+// Latest value published by one writer thread, readers never block it and retry if they raced with a write
+// T must be trivially copyable
+
+template <typename T>
+class SeqLock
+{
+    public:
+        SeqLock () : sequence (0), value () { }
+
+
+        void store (const T& newValue)  // Writer side, only one thread may call it
+        {
+            unsigned int currentSequence = sequence.load (std::memory_order_relaxed);
+
+            sequence.store (currentSequence + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence (std::memory_order_release);
+
+            std::memcpy (static_cast<void*> (&value), &newValue, sizeof (T));
+
+            sequence.store (currentSequence + 2, std::memory_order_release);
+        }
+
+        T load (unsigned int* version = nullptr) const  // Reader side, the version changes each time a new value is stored
+        {
+            T result;
+            unsigned int before, after;
+
+            do
+            {
+                before = sequence.load (std::memory_order_acquire);
+
+                std::memcpy (static_cast<void*> (&result), &value, sizeof (T));
+
+                std::atomic_thread_fence (std::memory_order_acquire);
+                after = sequence.load (std::memory_order_relaxed);
+            }
+            while (before != after || before & 1);
+
+            if (version)
+                *version = after;
+
+            return result;
+        }
+
+
+    private:
+        std::atomic<unsigned int> sequence;
+        T value;
+};
+
+
+#endif // SEQLOCK_H
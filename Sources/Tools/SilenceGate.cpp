@@ -0,0 +1,89 @@
+#include <cmath>
+
+#include "SilenceGate.h"
+
+
+static float decibelsToLevel (float decibels)
+{
+    return std::pow (10.0f, decibels / 20.0f);
+}
+
+
+SilenceGate::SilenceGate ()
+{
+    setThresholds (-45, -51);
+
+    attackTime = 0.005;
+    releaseTime = 0.15;
+    hangoverTime = 2;
+
+    reset ();
+}
+
+
+////////////////////////////////////////  Settings
+
+
+void SilenceGate::setThresholds (float openDecibels, float closeDecibels)  // In dBFS, the close threshold should be lower to get some hysteresis
+{
+    openThreshold = decibelsToLevel (openDecibels);
+    closeThreshold = decibelsToLevel (std::min (openDecibels, closeDecibels));
+}
+
+void SilenceGate::setAttack (unsigned int milliseconds)
+{
+    attackTime = milliseconds / 1000.0;
+}
+
+void SilenceGate::setRelease (unsigned int milliseconds)
+{
+    releaseTime = milliseconds / 1000.0;
+}
+
+void SilenceGate::setHangover (unsigned int milliseconds)
+{
+    hangoverTime = milliseconds / 1000.0;
+}
+
+
+////////////////////////////////////////  Processing
+
+
+void SilenceGate::reset ()  // Recordings start with an open gate
+{
+    envelope = openThreshold;
+    hangoverLeft = hangoverTime;
+    open = true;
+}
+
+bool SilenceGate::process (float level, double chunkDuration)  // Feed the RMS level of one chunk, returns the new state
+{
+    double smoothingTime = level > envelope ? attackTime : releaseTime;
+    float coefficient = smoothingTime > 0 ? 1 - std::exp (-chunkDuration / smoothingTime) : 1;
+
+    envelope += (level - envelope) * coefficient;
+
+
+    if (envelope >= openThreshold)
+    {
+        open = true;
+        hangoverLeft = hangoverTime;
+    }
+    else if (open && envelope < closeThreshold)
+    {
+        hangoverLeft -= chunkDuration;
+
+        if (hangoverLeft <= 0)
+            open = false;
+    }
+    else if (open)
+        hangoverLeft = hangoverTime;
+
+    return open;
+}
+
+
+bool SilenceGate::isOpen ()
+{
+    return open;
+}
@@ -0,0 +1,40 @@
+#ifndef SILENCEGATE_H
+#define SILENCEGATE_H
+
+
+// Energy gate deciding chunk by chunk if the input is worth recording
+// The level is smoothed by an attack / release envelope, the gate opens above the open threshold,
+// and closes once the envelope stayed under the lower close threshold for the whole hangover time
+
+class SilenceGate
+{
+    public:
+        SilenceGate ();
+
+
+        void setThresholds (float, float);
+        void setAttack (unsigned int);
+        void setRelease (unsigned int);
+        void setHangover (unsigned int);
+
+        void reset ();
+        bool process (float, double);
+
+        bool isOpen ();
+
+
+    private:
+        float openThreshold;
+        float closeThreshold;
+
+        double attackTime;
+        double releaseTime;
+        double hangoverTime;
+
+        float envelope;
+        double hangoverLeft;
+        bool open;
+};
+
+
+#endif // SILENCEGATE_H
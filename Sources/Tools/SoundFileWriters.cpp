@@ -0,0 +1,74 @@
+#include <atomic>
+#include <thread>
+#include <algorithm>
+#include <cctype>
+
+#include "SoundFileWriters.h"
+#include "FlacWriter.h"
+#include "OpusWriter.h"
+#include "WavWriter.h"
+
+
+static std::atomic<unsigned int> threadsSetting (0);
+static std::atomic<unsigned int> opusBitrateSetting (64000);
+static std::atomic<unsigned int> opusComplexitySetting (10);
+
+
+static bool hasExtension (const std::string& fileName, const std::string& extension)
+{
+    if (fileName.size () < extension.size () + 1 || fileName[fileName.size () - extension.size () - 1] != '.')
+        return false;
+
+    return std::equal (extension.begin (), extension.end (), fileName.end () - extension.size (), [] (char a, char b) { return std::tolower (a) == std::tolower (b); });
+}
+
+
+std::unique_ptr<sf::SoundFileWriter> SoundFileWriters::open (const std::string& fileName, unsigned int sampleRate, unsigned int channelCount)
+{
+    std::unique_ptr<sf::SoundFileWriter> writer;
+
+    if (hasExtension (fileName, "flac"))
+        writer.reset (new FlacWriter (encoderThreads ()));
+
+    else if (hasExtension (fileName, "opus"))
+        writer.reset (new OpusWriter (opusBitrate (), opusComplexity ()));
+
+    else if (hasExtension (fileName, "wav"))
+        writer.reset (new WavWriter);
+
+    else
+        writer.reset (sf::SoundFileFactory::createWriterFromFilename (fileName));
+
+    if (writer && !writer->open (fileName, sampleRate, channelCount))
+        writer.reset ();
+
+    return writer;
+}
+
+
+void SoundFileWriters::setEncoderThreads (unsigned int threads)
+{
+    threadsSetting = threads;
+}
+
+unsigned int SoundFileWriters::encoderThreads ()
+{
+    return threadsSetting != 0 ? threadsSetting.load () : std::max (1U, std::thread::hardware_concurrency ());
+}
+
+
+void SoundFileWriters::setOpusSettings (unsigned int bitrate, unsigned int complexity)
+{
+    opusBitrateSetting = bitrate;
+    opusComplexitySetting = complexity;
+}
+
+unsigned int SoundFileWriters::opusBitrate ()
+{
+    return opusBitrateSetting;
+}
+
+unsigned int SoundFileWriters::opusComplexity ()
+{
+    return opusComplexitySetting;
+}
@@ -0,0 +1,25 @@
+#ifndef SOUNDFILEWRITERS_H
+#define SOUNDFILEWRITERS_H
+
+
+#include <SFML/Audio.hpp>
+
+#include <memory>
+
+
+// Chooses the encoder of an output file from its extension : our own backends first, SFML ones for the other formats
+
+namespace SoundFileWriters
+{
+    std::unique_ptr<sf::SoundFileWriter> open (const std::string&, unsigned int, unsigned int);  // nullptr on failure
+
+    void setEncoderThreads (unsigned int);  // 0 for one per core
+    unsigned int encoderThreads ();
+
+    void setOpusSettings (unsigned int, unsigned int);  // Bitrate in bits per second, complexity from 0 to 10
+    unsigned int opusBitrate ();
+    unsigned int opusComplexity ();
+}
+
+
+#endif // SOUNDFILEWRITERS_H
@@ -0,0 +1,228 @@
+#include <cmath>
+#include <chrono>
+#include <algorithm>
+
+#include "SpectrumAnalyzer.h"
+
+
+static const double pi = 3.14159265358979323846;
+
+static const float lowestShownFrequency = 20;
+static const float highestShownFrequency = 20000;
+static const float silenceLevel = -120;  // dB, floor of the published magnitudes
+
+static std::atomic<unsigned int> defaultFFTSize (2048);
+static std::atomic<unsigned int> defaultOverlap (75);
+static std::atomic<unsigned short int> defaultBandCount (64);
+
+
+////////////////////////////////////////  Constructor / Destructor
+
+
+SpectrumAnalyzer::SpectrumAnalyzer ()
+{
+    stopRequested = false;
+
+    sampleRate = 44100;
+    channelCount = 1;
+    hop = 1;
+
+    powerScale = 1;
+    columnsBandCount = 0;
+}
+
+SpectrumAnalyzer::~SpectrumAnalyzer ()
+{
+    stop ();
+}
+
+
+////////////////////////////////////////  Thread control
+
+
+void SpectrumAnalyzer::start (unsigned int rate, unsigned int channels)
+{
+    stop ();
+
+    unsigned int fftSize, overlap;
+    unsigned short int bandCount;
+
+    defaultSettings (fftSize, overlap, bandCount);
+
+    if (rate == 0 || channels == 0 || !fft.setup (fftSize))
+        return;
+
+    sampleRate = rate;
+    channelCount = channels;
+    hop = std::max (1U, fftSize * (100 - overlap) / 100);
+
+
+    window.resize (fftSize);
+    double windowSum = 0;
+
+    for (unsigned int i = 0 ; i != fftSize ; i++)
+    {
+        window[i] = 0.5 - 0.5 * std::cos (2 * pi * i / fftSize);
+        windowSum += window[i];
+    }
+
+    powerScale = std::pow (2 / (windowSum * 32768), 2);
+
+    windowed.resize (fftSize);
+    power.resize (fftSize / 2 + 1);
+
+    frame.clear ();
+    frame.reserve (fftSize + hop);  // Never more than one window and one hop, no allocation while running
+
+    poppedSamples.resize (std::size_t (hop) * channelCount);
+    ring.allocate (std::max<std::size_t> (sampleRate / 2, 2 * (fftSize + hop)) * channelCount);
+
+
+    double binWidth = double (sampleRate) / fftSize;
+
+    result = SpectrumBands ();
+    result.bandCount = std::min (bandCount, SpectrumBands::maxBands);
+    result.lowestFrequency = std::max (lowestShownFrequency, float (binWidth));
+    result.highestFrequency = std::min (highestShownFrequency, sampleRate / 2.0f);
+
+    bandBins.resize (2 * result.bandCount);
+
+    for (unsigned short int band = 0 ; band != result.bandCount ; band++)
+    {
+        double ratio = double (result.highestFrequency) / result.lowestFrequency;
+        double lower = result.lowestFrequency * std::pow (ratio, double (band) / result.bandCount);
+        double upper = result.lowestFrequency * std::pow (ratio, double (band + 1) / result.bandCount);
+
+        unsigned int firstBin = std::min<unsigned int> (std::floor (lower / binWidth), fftSize / 2);
+
+        bandBins[2 * band] = firstBin;
+        bandBins[2 * band + 1] = std::max<unsigned int> (firstBin + 1, std::min<unsigned int> (std::ceil (upper / binWidth), fftSize / 2 + 1));
+    }
+
+    std::fill (result.magnitudes, result.magnitudes + result.bandCount, silenceLevel);
+    snapshot.store (result);
+
+    {
+        std::lock_guard<std::mutex> lock (columnsMutex);
+
+        columns.allocate (std::size_t (sampleRate / hop + 1) * result.bandCount);  // One second of columns
+        columnsBandCount = result.bandCount;
+    }
+
+
+    stopRequested = false;
+    thread = std::thread (&SpectrumAnalyzer::run, this);
+}
+
+void SpectrumAnalyzer::stop ()
+{
+    if (!thread.joinable ())
+        return;
+
+    stopRequested = true;
+    thread.join ();
+
+    snapshot.store (SpectrumBands ());
+
+    std::lock_guard<std::mutex> lock (columnsMutex);  // The columns of this run must not reach the display of the next one
+
+    columns.clear ();
+    columnsBandCount = 0;
+}
+
+
+void SpectrumAnalyzer::push (const sf::Int16* samples, std::size_t samplesCount)
+{
+    ring.push (samples, samplesCount);  // If the analysis is late the block is skipped, only the display suffers
+}
+
+SpectrumBands SpectrumAnalyzer::bands (unsigned int* version) const  // Safe to call from any thread
+{
+    return snapshot.load (version);
+}
+
+
+std::size_t SpectrumAnalyzer::popColumns (float* magnitudes, std::size_t capacity, unsigned short int& bandCount)
+{
+    std::lock_guard<std::mutex> lock (columnsMutex);
+
+    bandCount = columnsBandCount;
+
+    if (bandCount == 0)
+        return 0;
+
+    return columns.pop (magnitudes, capacity / bandCount * bandCount) / bandCount;
+}
+
+
+////////////////////////////////////////  Analysis
+
+
+void SpectrumAnalyzer::run ()
+{
+    while (!stopRequested)
+    {
+        if (ring.available () < poppedSamples.size ())
+            std::this_thread::sleep_for (std::chrono::milliseconds (5));
+
+        analyze ();
+    }
+}
+
+void SpectrumAnalyzer::analyze ()
+{
+    std::size_t readSamples = ring.pop (&poppedSamples[0], poppedSamples.size ());
+
+    while (readSamples != 0)
+    {
+        for (std::size_t i = 0 ; i < readSamples ; i += channelCount)
+        {
+            float mixed = 0;
+
+            for (unsigned int channel = 0 ; channel != channelCount ; channel++)
+                mixed += poppedSamples[i + channel];
+
+            frame.push_back (mixed / channelCount);
+        }
+
+        while (frame.size () >= fft.size ())
+        {
+            for (unsigned int i = 0 ; i != fft.size () ; i++)
+                windowed[i] = frame[i] * window[i];
+
+            fft.powerSpectrum (&windowed[0], &power[0]);
+
+            for (unsigned short int band = 0 ; band != result.bandCount ; band++)
+            {
+                float loudest = *std::max_element (power.begin () + bandBins[2 * band], power.begin () + bandBins[2 * band + 1]);
+
+                result.magnitudes[band] = std::max (silenceLevel, 10 * std::log10 (loudest * powerScale + 1e-30f));
+            }
+
+            snapshot.store (result);
+            columns.push (result.magnitudes, result.bandCount);  // Lost if the display does not read them
+
+            frame.erase (frame.begin (), frame.begin () + hop);
+        }
+
+        readSamples = ring.pop (&poppedSamples[0], poppedSamples.size ());
+    }
+}
+
+
+////////////////////////////////////////  Settings
+
+
+void SpectrumAnalyzer::setDefaultSettings (unsigned int fftSize, unsigned int overlap, unsigned short int bandCount)  // Applied at the next start
+{
+    defaultFFTSize = fftSize;
+    defaultOverlap = std::min (overlap, 95U);
+    defaultBandCount = std::max<unsigned short int> (1, std::min (bandCount, SpectrumBands::maxBands));
+}
+
+void SpectrumAnalyzer::defaultSettings (unsigned int& fftSize, unsigned int& overlap, unsigned short int& bandCount)
+{
+    fftSize = defaultFFTSize;
+    overlap = defaultOverlap;
+    bandCount = defaultBandCount;
+}
@@ -0,0 +1,86 @@
+#ifndef SPECTRUMANALYZER_H
+#define SPECTRUMANALYZER_H
+
+
+#include <SFML/Audio.hpp>
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "FFT.h"
+#include "RingBuffer.h"
+#include "SeqLock.h"
+
+
+// Magnitudes of the last analyzed window, in dB relative to a full scale sine, grouped in logarithmic frequency bands
+
+struct SpectrumBands
+{
+    static const unsigned short int maxBands = 128;
+
+    unsigned short int bandCount;
+    float magnitudes[maxBands];
+
+    float lowestFrequency;  // Lower edge of the first band and upper edge of the last one, in hertz
+    float highestFrequency;
+
+
+    SpectrumBands () : bandCount (0), magnitudes (), lowestFrequency (0), highestFrequency (0) { }
+};
+
+
+// The capture thread only copies its samples into a ring, the analysis thread mixes them down to mono,
+// applies a Hann window every hop and publishes the bands, all buffers being allocated when it starts
+// Every analyzed window is also queued as a column of bands, for the displays that must not miss any
+
+class SpectrumAnalyzer
+{
+    public:
+        SpectrumAnalyzer ();
+        ~SpectrumAnalyzer ();
+
+        void start (unsigned int, unsigned int);  // Sample rate and channels, not thread safe with push
+        void stop ();
+
+        void push (const sf::Int16*, std::size_t);  // Capture thread, never blocks
+        SpectrumBands bands (unsigned int* = nullptr) const;
+        std::size_t popColumns (float*, std::size_t, unsigned short int&);  // As many columns as fit in N floats, oldest first, with their bands count, from a single reader thread
+
+        static void setDefaultSettings (unsigned int, unsigned int, unsigned short int);  // FFT size, overlap in percent and bands count
+        static void defaultSettings (unsigned int&, unsigned int&, unsigned short int&);
+
+
+    private:
+        void run ();
+        void analyze ();
+
+
+        std::thread thread;
+        std::atomic<bool> stopRequested;
+
+        unsigned int sampleRate;
+        unsigned int channelCount;
+        unsigned int hop;
+
+        RingBuffer<sf::Int16> ring;
+        std::vector<sf::Int16> poppedSamples;
+
+        RealFFT fft;
+        std::vector<float> window;
+        std::vector<float> frame;  // Mono samples waiting for the next analysis, the oldest first
+        std::vector<float> windowed;
+        std::vector<float> power;
+        float powerScale;  // Brings a full scale sine to 1
+
+        std::vector<unsigned int> bandBins;  // First and past the last bin of each band, the narrow low bands may share a bin
+        SpectrumBands result;
+        SeqLock<SpectrumBands> snapshot;
+        RingBuffer<float> columns;
+        unsigned short int columnsBandCount;
+        std::mutex columnsMutex;  // Between the reader and start or stop, the analysis thread pushes without it
+};
+
+
+#endif // SPECTRUMANALYZER_H
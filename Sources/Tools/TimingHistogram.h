@@ -0,0 +1,99 @@
+#ifndef TIMINGHISTOGRAM_H
+#define TIMINGHISTOGRAM_H
+
+
+#include <atomic>
+#include <algorithm>
+
+
+// Durations in microseconds counted in power of two buckets, filled by one thread while any other one reads it without lock
+
+class TimingHistogram
+{
+    public:
+        static const unsigned short int bucketsCount = 24;  // The last bucket holds everything above 4 seconds
+
+
+        TimingHistogram () { clear (); }
+
+
+        void clear ()  // Not thread safe
+        {
+            for (unsigned short int i = 0 ; i != bucketsCount ; i++)
+                buckets[i].store (0, std::memory_order_relaxed);
+
+            _count.store (0, std::memory_order_relaxed);
+            _sum.store (0, std::memory_order_relaxed);
+            _maximum.store (0, std::memory_order_relaxed);
+        }
+
+        void add (unsigned long long int microseconds)  // Writer side
+        {
+            unsigned short int bucket = 0;
+
+            while (bucket != bucketsCount - 1 && microseconds >= bucketLimit (bucket))
+                bucket++;
+
+            buckets[bucket].fetch_add (1, std::memory_order_relaxed);
+            _count.fetch_add (1, std::memory_order_relaxed);
+            _sum.fetch_add (microseconds, std::memory_order_relaxed);
+
+            if (microseconds > _maximum.load (std::memory_order_relaxed))
+                _maximum.store (microseconds, std::memory_order_relaxed);
+        }
+
+
+        static unsigned long long int bucketLimit (unsigned short int bucket)  // Values of a bucket are below this limit
+        {
+            return 1ULL << bucket;
+        }
+
+        unsigned long long int bucket (unsigned short int index) const
+        {
+            return buckets[index].load (std::memory_order_relaxed);
+        }
+
+        unsigned long long int count () const
+        {
+            return _count.load (std::memory_order_relaxed);
+        }
+
+        double mean () const
+        {
+            unsigned long long int values = count ();
+
+            return values != 0 ? double (_sum.load (std::memory_order_relaxed)) / values : 0;
+        }
+
+        unsigned long long int maximum () const
+        {
+            return _maximum.load (std::memory_order_relaxed);
+        }
+
+        unsigned long long int percentile (double fraction) const  // Upper limit of the bucket holding this fraction of the values
+        {
+            unsigned long long int values = count ();
+            unsigned long long int seen = 0;
+
+            for (unsigned short int i = 0 ; i != bucketsCount ; i++)
+            {
+                seen += bucket (i);
+
+                if (values != 0 && seen >= fraction * values)
+                    return std::min (bucketLimit (i), maximum ());
+            }
+
+            return maximum ();
+        }
+
+
+    private:
+        std::atomic<unsigned long long int> buckets[bucketsCount];
+
+        std::atomic<unsigned long long int> _count;
+        std::atomic<unsigned long long int> _sum;
+        std::atomic<unsigned long long int> _maximum;
+};
+
+
+#endif // TIMINGHISTOGRAM_H
@@ -0,0 +1,145 @@
+#include <cstdio>
+#include <algorithm>
+
+#include "VorbisReader.h"
+
+
+////////////////////////////////////////  Stream callbacks
+
+
+static std::size_t readCallback (void* buffer, std::size_t size, std::size_t count, void* data)
+{
+    sf::Int64 readBytes = static_cast<sf::InputStream*> (data)->read (buffer, size * count);
+
+    return readBytes > 0 ? std::size_t (readBytes) / size : 0;
+}
+
+static int seekCallback (void* data, ogg_int64_t offset, int whence)
+{
+    sf::InputStream* stream = static_cast<sf::InputStream*> (data);
+
+    if (whence == SEEK_CUR)
+        offset += stream->tell ();
+
+    else if (whence == SEEK_END)
+        offset += stream->getSize ();
+
+    return stream->seek (offset) == offset ? 0 : -1;
+}
+
+static long tellCallback (void* data)
+{
+    return long (static_cast<sf::InputStream*> (data)->tell ());
+}
+
+
+////////////////////////////////////////  SFML reader interface
+
+
+VorbisReader::VorbisReader (const SeekIndex* seekIndex)
+{
+    index = seekIndex;
+    opened = false;
+    channelCount = 1;
+}
+
+VorbisReader::~VorbisReader ()
+{
+    close ();
+}
+
+
+bool VorbisReader::open (sf::InputStream& stream, Info& info)
+{
+    close ();
+
+    ov_callbacks callbacks = {&readCallback, &seekCallback, nullptr, &tellCallback};
+
+    if (ov_open_callbacks (&stream, &vorbis, nullptr, 0, callbacks) < 0)
+        return false;
+
+    opened = true;
+
+    vorbis_info* vorbisInfo = ov_info (&vorbis, -1);
+
+    if (vorbisInfo == nullptr || vorbisInfo->channels <= 0)
+    {
+        close ();
+        return false;
+    }
+
+    channelCount = vorbisInfo->channels;
+
+    info.channelCount = channelCount;
+    info.sampleRate = vorbisInfo->rate;
+    info.sampleCount = sf::Uint64 (std::max<ogg_int64_t> (0, ov_pcm_total (&vorbis, -1))) * channelCount;
+
+    return true;
+}
+
+void VorbisReader::close ()
+{
+    if (opened)
+        ov_clear (&vorbis);
+
+    opened = false;
+}
+
+
+void VorbisReader::seek (sf::Uint64 sampleOffset)
+{
+    ogg_int64_t target = sampleOffset / channelCount;
+    SeekPoint point;
+
+    // One point of margin : the first packet after a jump only primes the decoder
+    for (unsigned int earlier = 1 ; index != nullptr && earlier != 3 && index->find (target, point, earlier) ; earlier++)
+    {
+        if (ov_raw_seek (&vorbis, point.offset) != 0)
+            break;
+
+        ogg_int64_t position = ov_pcm_tell (&vorbis);
+
+        if (position >= 0 && position <= target)
+        {
+            skip (target - position);
+            return;
+        }
+    }
+
+    ov_pcm_seek (&vorbis, target);  // No index, or it did not match the file
+}
+
+void VorbisReader::skip (unsigned long long int frames)  // Decode and drop, less than a page in practice
+{
+    skippedSamples.resize (4096 * channelCount);
+
+    while (frames != 0)
+    {
+        sf::Uint64 readSamples = read (&skippedSamples[0], std::min<unsigned long long int> (frames, 4096) * channelCount);
+
+        if (readSamples == 0)
+            return;
+
+        frames -= readSamples / channelCount;
+    }
+}
+
+
+sf::Uint64 VorbisReader::read (sf::Int16* samples, sf::Uint64 maxCount)
+{
+    sf::Uint64 count = 0;
+
+    while (count < maxCount)
+    {
+        int bytesToRead = int (std::min<sf::Uint64> (maxCount - count, 4096) * sizeof (sf::Int16));
+        long readBytes = ov_read (&vorbis, reinterpret_cast<char*> (samples + count), bytesToRead, 0, 2, 1, nullptr);
+
+        if (readBytes > 0)
+            count += readBytes / sizeof (sf::Int16);
+
+        else if (readBytes != OV_HOLE)  // End of the file or error, a hole is only a gap in the data
+            break;
+    }
+
+    return count;
+}
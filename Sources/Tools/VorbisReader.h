@@ -0,0 +1,43 @@
+#ifndef VORBISREADER_H
+#define VORBISREADER_H
+
+
+#include <SFML/Audio.hpp>
+
+#include <vorbis/vorbisfile.h>
+
+#include <vector>
+
+#include "SeekIndex.h"
+
+
+// Ogg Vorbis decoder through libvorbisfile, as the SFML one, except for seeking : with an index of the file
+// it jumps to a page just before the target and decodes up to the exact sample, instead of bisecting the file
+
+class VorbisReader : public sf::SoundFileReader
+{
+    public:
+        explicit VorbisReader (const SeekIndex* = nullptr);
+        virtual ~VorbisReader ();
+
+        virtual bool open (sf::InputStream&, Info&) override;
+        virtual void seek (sf::Uint64) override;
+        virtual sf::Uint64 read (sf::Int16*, sf::Uint64) override;
+
+
+    private:
+        void close ();
+        void skip (unsigned long long int);
+
+
+        const SeekIndex* index;
+
+        OggVorbis_File vorbis;
+        bool opened;
+        unsigned int channelCount;
+
+        std::vector<sf::Int16> skippedSamples;
+};
+
+
+#endif // VORBISREADER_H
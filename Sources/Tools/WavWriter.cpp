@@ -0,0 +1,294 @@
+#ifdef _WIN32
+    #if !defined (_WIN32_WINNT) || _WIN32_WINNT < 0x0600  // File allocation info needs Vista
+        #undef _WIN32_WINNT
+        #define _WIN32_WINNT 0x0600
+    #endif
+
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+#include <cstring>
+#include <memory>
+#include <algorithm>
+
+#include "WavWriter.h"
+
+
+static const std::size_t bufferSize = 1 << 20;  // Every write covers one whole MiB of the file, at a MiB boundary
+static const std::size_t bufferAlignment = 4096;
+
+static const unsigned long long int minExtent = 16ULL << 20;
+static const unsigned long long int maxExtent = 1ULL << 30;
+
+static const unsigned short int headerSize = 80;  // RIFF, JUNK reserved for ds64, fmt and data chunk headers
+static const unsigned long long int riffLimit = 0xFFFFFFFFULL;
+
+
+static void putLittleEndian (unsigned char* bytes, unsigned long long int value, unsigned short int size)
+{
+    for (unsigned short int i = 0 ; i != size ; i++)
+        bytes[i] = (unsigned char) (value >> (8 * i));
+}
+
+
+////////////////////////////////////////  Constructor / Destructor
+
+
+WavWriter::WavWriter () : sf::SoundFileWriter ()
+{
+#ifdef _WIN32
+    handle = INVALID_HANDLE_VALUE;
+#else
+    descriptor = -1;
+#endif
+    opened = false;
+
+    sampleRate = 44100;
+    channelCount = 2;
+
+    storage.resize (bufferSize + bufferAlignment);
+
+    void* alignedStorage = storage.data ();
+    std::size_t space = storage.size ();
+    buffer = static_cast<unsigned char*> (std::align (bufferAlignment, bufferSize, alignedStorage, space));
+
+    bufferedBytes = 0;
+    bufferOffset = 0;
+    allocatedBytes = 0;
+}
+
+WavWriter::~WavWriter ()
+{
+    close ();
+}
+
+
+////////////////////////////////////////  SFML writer interface
+
+
+bool WavWriter::open (const std::string& fileName, unsigned int rate, unsigned int channels)
+{
+    close ();
+
+    if (channels == 0 || channels > 18 || rate == 0)
+        return false;
+
+    if (!openFile (fileName))
+        return false;
+
+    opened = true;
+
+    sampleRate = rate;
+    channelCount = channels;
+
+    bufferOffset = 0;
+    allocatedBytes = 0;
+
+    std::memset (buffer, 0, headerSize);  // Written when closing, and each time a new extent is reserved
+    bufferedBytes = headerSize;
+
+    return true;
+}
+
+void WavWriter::write (const sf::Int16* samples, sf::Uint64 samplesCount)  // Samples are copied as they are, every supported platform is little endian
+{
+    if (!opened)
+        return;
+
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*> (samples);
+    std::size_t remainingBytes = samplesCount * sizeof (sf::Int16);
+
+    while (remainingBytes != 0)
+    {
+        std::size_t copiedBytes = std::min (remainingBytes, bufferSize - bufferedBytes);
+
+        std::memcpy (buffer + bufferedBytes, bytes, copiedBytes);
+
+        bufferedBytes += copiedBytes;
+        bytes += copiedBytes;
+        remainingBytes -= copiedBytes;
+
+        if (bufferedBytes == bufferSize)
+            flush ();
+    }
+}
+
+
+////////////////////////////////////////  Writing
+
+
+void WavWriter::flush ()
+{
+    if (bufferedBytes == 0)
+        return;
+
+    unsigned long long int end = bufferOffset + bufferSize;  // Whole blocks are reserved, even for the last partial one
+
+    if (end > allocatedBytes)
+    {
+        unsigned long long int extent = std::min (std::max (allocatedBytes / 4, minExtent), maxExtent);
+
+        preallocate (allocatedBytes + extent);
+        allocatedBytes += extent;
+
+        if (bufferOffset != 0)  // Sizes up to date at each extent, so a crash leaves a readable file
+            writeHeader (bufferOffset);
+    }
+
+    writeAt (bufferOffset, buffer, bufferedBytes);
+
+    if (bufferedBytes == bufferSize)
+    {
+        bufferOffset += bufferSize;
+        bufferedBytes = 0;
+    }
+}
+
+void WavWriter::writeHeader (unsigned long long int fileSize)
+{
+    unsigned char header[headerSize] = {};
+
+    unsigned long long int dataSize = fileSize - headerSize;
+    bool rf64 = fileSize - 8 > riffLimit;
+
+    std::memcpy (header, rf64 ? "RF64" : "RIFF", 4);
+    putLittleEndian (header + 4, rf64 ? riffLimit : fileSize - 8, 4);
+    std::memcpy (header + 8, "WAVE", 4);
+
+    std::memcpy (header + 12, rf64 ? "ds64" : "JUNK", 4);
+    putLittleEndian (header + 16, 28, 4);
+
+    if (rf64)
+    {
+        putLittleEndian (header + 20, fileSize - 8, 8);
+        putLittleEndian (header + 28, dataSize, 8);
+        putLittleEndian (header + 36, dataSize / (2 * channelCount), 8);  // Table length left at 0
+    }
+
+    std::memcpy (header + 48, "fmt ", 4);
+    putLittleEndian (header + 52, 16, 4);
+    putLittleEndian (header + 56, 1, 2);  // Integer PCM
+    putLittleEndian (header + 58, channelCount, 2);
+    putLittleEndian (header + 60, sampleRate, 4);
+    putLittleEndian (header + 64, sampleRate * 2 * channelCount, 4);
+    putLittleEndian (header + 68, 2 * channelCount, 2);
+    putLittleEndian (header + 70, 16, 2);
+
+    std::memcpy (header + 72, "data", 4);
+    putLittleEndian (header + 76, rf64 ? riffLimit : dataSize, 4);
+
+    writeAt (0, header, headerSize);
+}
+
+void WavWriter::close ()
+{
+    if (!opened)
+        return;
+
+    unsigned long long int fileSize = bufferOffset + bufferedBytes;
+
+    flush ();
+    writeHeader (fileSize);
+    truncate (fileSize);
+
+    closeFile ();
+    opened = false;
+}
+
+
+////////////////////////////////////////  Platform file access
+
+
+#ifdef _WIN32
+
+bool WavWriter::openFile (const std::string& fileName)
+{
+    handle = CreateFileA (fileName.c_str (), GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+
+    return handle != INVALID_HANDLE_VALUE;
+}
+
+bool WavWriter::writeAt (unsigned long long int offset, const unsigned char* bytes, std::size_t size)
+{
+    OVERLAPPED position = {};
+    position.Offset = DWORD (offset & 0xFFFFFFFF);
+    position.OffsetHigh = DWORD (offset >> 32);
+
+    DWORD written = 0;
+
+    return WriteFile (handle, bytes, DWORD (size), &written, &position) && written == size;
+}
+
+bool WavWriter::preallocate (unsigned long long int size)  // Reserves clusters without moving the end of file
+{
+    FILE_ALLOCATION_INFO allocation;
+    allocation.AllocationSize.QuadPart = size;
+
+    return SetFileInformationByHandle (handle, FileAllocationInfo, &allocation, sizeof (allocation));
+}
+
+bool WavWriter::truncate (unsigned long long int size)  // Also gives back the clusters reserved past the end
+{
+    LARGE_INTEGER end;
+    end.QuadPart = size;
+
+    return SetFilePointerEx (handle, end, nullptr, FILE_BEGIN) && SetEndOfFile (handle) && preallocate (size);
+}
+
+void WavWriter::closeFile ()
+{
+    CloseHandle (handle);
+    handle = INVALID_HANDLE_VALUE;
+}
+
+#else
+
+bool WavWriter::openFile (const std::string& fileName)
+{
+    descriptor = ::open (fileName.c_str (), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+    return descriptor != -1;
+}
+
+bool WavWriter::writeAt (unsigned long long int offset, const unsigned char* bytes, std::size_t size)
+{
+    while (size != 0)
+    {
+        ssize_t written = ::pwrite (descriptor, bytes, size, offset);
+
+        if (written <= 0)
+            return false;
+
+        bytes += written;
+        size -= written;
+        offset += written;
+    }
+
+    return true;
+}
+
+bool WavWriter::preallocate (unsigned long long int size)  // Reserves blocks without moving the end of file, where the system allows it
+{
+#ifdef __linux__
+    return ::fallocate (descriptor, FALLOC_FL_KEEP_SIZE, 0, size) == 0;
+#else
+    (void) size;
+    return false;
+#endif
+}
+
+bool WavWriter::truncate (unsigned long long int size)  // Also frees the blocks reserved past the end
+{
+    return ::ftruncate (descriptor, size) == 0;
+}
+
+void WavWriter::closeFile ()
+{
+    ::close (descriptor);
+    descriptor = -1;
+}
+
+#endif
@@ -0,0 +1,54 @@
+#ifndef WAVWRITER_H
+#define WAVWRITER_H
+
+
+#include <SFML/Audio.hpp>
+
+#include <vector>
+
+
+// 16 bits PCM writer for long captures : the file grows by large preallocated extents, is written by big aligned blocks,
+// and is trimmed to its real size when closed, becoming RF64 (EBU Tech 3306) past the 4 GiB limit of RIFF
+
+class WavWriter : public sf::SoundFileWriter
+{
+    public:
+        WavWriter ();
+        virtual ~WavWriter ();
+
+        virtual bool open (const std::string&, unsigned int, unsigned int) override;
+        virtual void write (const sf::Int16*, sf::Uint64) override;
+
+
+    private:
+        void flush ();
+        void writeHeader (unsigned long long int);
+        void close ();
+
+        bool openFile (const std::string&);
+        bool writeAt (unsigned long long int, const unsigned char*, std::size_t);
+        bool preallocate (unsigned long long int);
+        bool truncate (unsigned long long int);
+        void closeFile ();
+
+
+#ifdef _WIN32
+        void* handle;
+#else
+        int descriptor;
+#endif
+        bool opened;
+
+        unsigned int sampleRate;
+        unsigned int channelCount;
+
+        std::vector<unsigned char> storage;
+        unsigned char* buffer;  // Aligned inside storage, holds the bytes of the file from bufferOffset
+        std::size_t bufferedBytes;
+
+        unsigned long long int bufferOffset;
+        unsigned long long int allocatedBytes;
+};
+
+
+#endif // WAVWRITER_H
@@ -1,11 +1,29 @@
-#include "Application.h"
-
-
-int main (int argc, char** argv)
-{
-    QApplication app (argc, argv);
-
-
-    Application MRecorder;
-    return app.exec();
-}
+#include <cstring>
+
+#include "Application.h"
+#include "CommandLineRecorder.h"
+#include "Tools/OpusReader.h"
+
+
+int main (int argc, char** argv)
+{
+    sf::SoundFileFactory::registerReader<OpusReader> ();  // Every sf::InputSoundFile then reads the Opus recordings
+
+
+    if (argc > 1 && (std::strcmp (argv[1], "record") == 0 || std::strcmp (argv[1], "devices") == 0 || std::strcmp (argv[1], "benchmark") == 0))  // Headless mode, the GUI is never loaded
+    {
+        QCoreApplication app (argc, argv);
+        CommandLineRecorder recorder;
+
+        int exitCode = recorder.run (app.arguments ());
+
+        return exitCode >= 0 ? exitCode : app.exec ();
+    }
+
+
+    QApplication app (argc, argv);
+
+
+    Application MRecorder;
+    return app.exec();
+}